@@ -0,0 +1,294 @@
+// Microbenchmarks de los caminos calientes del bucle de juego.
+// Salida: un objeto JSON por stdout (o en --out FICHERO) para poder
+// comparar commits con un diff o un script.
+//
+//   bench [--quick] [--out FICHERO]
+
+#include "World.hpp"
+#include "StateMachine.hpp"
+#include "GameState.hpp"
+#include "Autopilot.hpp"
+#include "Flock.hpp"
+#include "ReferencePlayer.hpp"
+
+#if BENCH_WITH_RAYLIB
+#include "AssetPack.hpp"
+extern "C" {
+    #include <raylib.h>
+}
+#endif
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+double secondsSince(Clock::time_point t0) {
+    return std::chrono::duration<double>(Clock::now() - t0).count();
+}
+
+// Evita que el optimizador se coma el trabajo medido
+volatile int g_sink = 0;
+
+struct Result {
+    std::string name;
+    double value;
+    const char* unit;
+};
+
+std::vector<Result> g_results;
+
+void report(const std::string& name, double value, const char* unit) {
+    g_results.push_back(Result{name, value, unit});
+    std::fprintf(stderr, "%-40s %14.2f %s\n", name.c_str(), value, unit);
+}
+
+// --- 1. Ticks/s equivalentes a MainGameState::update
+void benchWorldStep(long long ticks) {
+    WorldParams params;
+    World w;
+    uint32_t seed = 1;
+    w.reset(params, seed);
+
+    const float dt = 1.0f / 240.0f;
+    auto t0 = Clock::now();
+    for (long long i = 0; i < ticks; i++) {
+        w.step(dt, referenceFlap(w));
+        if (w.dead()) w.reset(params, ++seed);
+    }
+    const double s = secondsSince(t0);
+    g_sink += w.score();
+    report("world_step", (double)ticks / s, "ticks/s");
+}
+
+// --- 2. Coste de spawnear: advance con spawn frente a advance sin spawn
+void benchSpawn(int iterations) {
+    WorldParams params;
+    const float gap = gapFor(params);
+
+    // dt = spawnEvery → cada advance spawnea exactamente una pareja
+    PipeField spawning;
+    spawning.reset(params, gap, 7);
+    auto t0 = Clock::now();
+    for (int i = 0; i < iterations; i++) spawning.advance(params.spawnEvery, params.birdStartX);
+    const double withSpawn = secondsSince(t0) / iterations;
+
+    // dt diminuto → ningún spawn en todo el bucle
+    PipeField idle;
+    idle.reset(params, gap, 7);
+    const float tiny = params.spawnEvery / (float)(iterations + 1);
+    t0 = Clock::now();
+    for (int i = 0; i < iterations; i++) idle.advance(tiny, params.birdStartX);
+    const double without = secondsSince(t0) / iterations;
+
+    g_sink += spawning.count() + idle.count();
+    report("pipe_advance_with_spawn", withSpawn * 1e9, "ns/call");
+    report("pipe_advance_no_spawn", without * 1e9, "ns/call");
+    report("pipe_spawn", (withSpawn - without) * 1e9, "ns/spawn");
+}
+
+// --- 3. Colisión frente a número de tuberías vivas: broad phase del
+// PipeField contra recorrer todas las parejas
+void benchCollision(int queries) {
+    const int counts[] = {2, 4, 8, 16, 32, 64, 128};
+    for (int live : counts) {
+        WorldParams params;
+        // Separación tal que quepan ~live parejas en pantalla a la vez
+        params.spawnEvery = (params.screenW + params.pipeW) / (params.pipeSpeed * (float)live);
+        PipeField f;
+        f.reset(params, gapFor(params), 11);
+        const float dt = 1.0f / 240.0f;
+        for (int i = 0; i < 4000; i++) f.advance(dt, params.birdStartX);
+
+        const Rectangle bird{ params.birdStartX, 200.0f, (float)params.birdW, (float)params.birdH };
+
+        int hits = 0;
+        auto t0 = Clock::now();
+        for (int q = 0; q < queries; q++) {
+            Rectangle bb = bird;
+            bb.y = (float)(q & 255) + 40.0f;
+            int first, last;
+            f.overlapping(bb.x, bb.x + bb.width, first, last);
+            for (int i = first; i < last; i++) {
+                hits += overlaps(bb, f.topRect(f[i])) || overlaps(bb, f.botRect(f[i]));
+            }
+        }
+        const double broad = secondsSince(t0) / queries;
+
+        t0 = Clock::now();
+        for (int q = 0; q < queries; q++) {
+            Rectangle bb = bird;
+            bb.y = (float)(q & 255) + 40.0f;
+            for (int i = 0; i < f.count(); i++) {
+                hits += overlaps(bb, f.topRect(f[i])) || overlaps(bb, f.botRect(f[i]));
+            }
+        }
+        const double full = secondsSince(t0) / queries;
+        g_sink += hits;
+
+        const std::string suffix = "_live" + std::to_string(f.count());
+        report("collision_broadphase" + suffix, broad * 1e9, "ns/query");
+        report("collision_fullscan" + suffix, full * 1e9, "ns/query");
+    }
+}
+
+// --- 4. Transiciones del StateMachine con estados vacíos
+class NullState : public GameState {
+public:
+    void init() override { g_sink++; }
+    void handleInput() override {}
+    void update(float) override {}
+    void render(float) override {}
+    void pause() override {}
+    void resume() override {}
+};
+
+void benchTransitions(int transitions) {
+    StateMachine sm;
+    float dt = 0.0f;
+    sm.add_state(std::make_unique<NullState>(), false);
+    sm.handle_state_changes(dt);
+
+    auto t0 = Clock::now();
+    for (int i = 0; i < transitions; i++) {
+        sm.add_state(std::make_unique<NullState>(), true);
+        sm.handle_state_changes(dt);
+    }
+    const double s = secondsSince(t0) / transitions;
+    report("state_transition", s * 1e9, "ns/transition");
+}
+
+// --- 5. Piloto automático: una decisión (MainGameState) y por lotes sobre
+// los arrays de un Flock. El coste no depende de los pesos: unos cualesquiera.
+void benchAutopilot(int decisions) {
+    Autopilot::Weights w;
+    uint32_t h = 0x9E3779B9u;
+    float* raw = &w.w1[0][0];
+    for (int i = 0; i < Autopilot::HIDDEN * Autopilot::INPUTS; i++) {
+        h = h * 1664525u + 1013904223u;
+        raw[i] = (float)(h >> 8) / 8388608.0f - 1.0f;
+    }
+    for (int j = 0; j < Autopilot::HIDDEN; j++) { w.b1[j] = 0.1f * (float)(j - 4); w.w2[j] = (j & 1) ? 1.0f : -1.0f; }
+    Autopilot pilot;
+    pilot.setWeights(w);
+
+    WorldParams params;
+    World world;
+    world.reset(params, 3);
+    for (int i = 0; i < 2000; i++) world.step(1.0f / 240.0f, referenceFlap(world));   // ya con tuberías
+
+    int flaps = 0;
+    auto t0 = Clock::now();
+    for (int i = 0; i < decisions; i++) flaps += pilot.decide(world);
+    report("autopilot_decide_single", secondsSince(t0) / decisions * 1e9, "ns/decision");
+
+    const int BIRDS = 1024;
+    Flock flock;
+    flock.reset(params, 3, BIRDS);
+    std::vector<uint8_t> out(BIRDS);
+    const int batches = std::max(1, decisions / BIRDS);
+    t0 = Clock::now();
+    for (int i = 0; i < batches; i++) {
+        const Autopilot::Gap gap = Autopilot::nearestGap(params, world.pipes(), flock.birdX());
+        pilot.decide(params, gap, flock.y(), flock.vy(), BIRDS, out.data());
+        flaps += out[i % BIRDS];
+    }
+    report("autopilot_decide_batch1024", secondsSince(t0) / ((double)batches * BIRDS) * 1e9, "ns/bird");
+    g_sink += flaps;
+}
+
+#if BENCH_WITH_RAYLIB
+// --- 6. Carga de texturas: decodificar PNG y subir a GPU, por asset
+void benchTextureLoads() {
+    SetTraceLogLevel(LOG_WARNING);
+    SetConfigFlags(FLAG_WINDOW_HIDDEN);
+    InitWindow(288, 512, "bench");
+    if (!IsWindowReady()) {
+        std::fprintf(stderr, "sin ventana/GL: se omite la carga de texturas\n");
+        return;
+    }
+
+    double allPng = 0.0;
+    FilePathList files = LoadDirectoryFilesEx("assets", ".png", false);
+    for (unsigned int i = 0; i < files.count; i++) {
+        const char* path = files.paths[i];
+
+        auto t0 = Clock::now();
+        Image img = LoadImage(path);
+        const double decode = secondsSince(t0);
+
+        t0 = Clock::now();
+        Texture2D tex = LoadTextureFromImage(img);
+        const double upload = secondsSince(t0);
+
+        UnloadTexture(tex);
+        UnloadImage(img);
+        allPng += decode + upload;
+
+        const std::string name = GetFileNameWithoutExt(path);
+        report("texture_decode_" + name, decode * 1e6, "us");
+        report("texture_upload_" + name, upload * 1e6, "us");
+    }
+    UnloadDirectoryFiles(files);
+    report("texture_load_all_png", allPng * 1e6, "us");
+
+    // Lo mismo desde el pack (si se generó con tools/packer): mapear + una subida
+    auto t0 = Clock::now();
+    AssetPack pack;
+    if (pack.open("assets/pack.fbpak")) {
+        Image img{ const_cast<uint8_t*>(pack.pixels()), pack.width(), pack.height(), 1,
+                   PIXELFORMAT_UNCOMPRESSED_R8G8B8A8 };
+        Texture2D tex = LoadTextureFromImage(img);
+        report("texture_load_pack", secondsSince(t0) * 1e6, "us");
+        UnloadTexture(tex);
+    }
+    CloseWindow();
+}
+#endif
+
+void writeJson(FILE* out) {
+    std::fprintf(out, "{\n  \"benchmarks\": [\n");
+    for (size_t i = 0; i < g_results.size(); i++) {
+        const Result& r = g_results[i];
+        std::fprintf(out, "    {\"name\": \"%s\", \"value\": %.3f, \"unit\": \"%s\"}%s\n",
+                     r.name.c_str(), r.value, r.unit, i + 1 < g_results.size() ? "," : "");
+    }
+    std::fprintf(out, "  ]\n}\n");
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    bool quick = false;
+    const char* outPath = nullptr;
+    for (int i = 1; i < argc; i++) {
+        if (!std::strcmp(argv[i], "--quick")) quick = true;
+        else if (!std::strcmp(argv[i], "--out") && i + 1 < argc) outPath = argv[++i];
+    }
+    const int scale = quick ? 1 : 10;
+
+    benchWorldStep(2000000LL * scale);
+    benchSpawn(200000 * scale);
+    benchCollision(200000 * scale);
+    benchTransitions(100000 * scale);
+    benchAutopilot(2000000 * scale);
+#if BENCH_WITH_RAYLIB
+    benchTextureLoads();
+#endif
+
+    FILE* out = outPath ? std::fopen(outPath, "w") : stdout;
+    if (!out) {
+        std::fprintf(stderr, "no se pudo abrir %s\n", outPath);
+        return 1;
+    }
+    writeJson(out);
+    if (out != stdout) std::fclose(out);
+    return g_sink == 0x7fffffff;   // nunca; solo para usar g_sink
+}
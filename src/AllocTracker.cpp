@@ -0,0 +1,96 @@
+#include "AllocTracker.hpp"
+#include <cstring>
+
+bool FrameAllocAudit::endFrame(const char* stateName, bool stateChanged) {
+    last_ = allocCount() - start_;
+
+    if (stateChanged) sinceChange_ = 0;
+    const bool steady = sinceChange_ >= warmup_;
+    sinceChange_++;
+
+    // Nombres de estado: literales, pocos; búsqueda lineal sin reservar
+    StateAllocs* st = nullptr;
+    for (int i = 0; i < count_; i++) {
+        if (!std::strcmp(states_[i].name, stateName)) { st = &states_[i]; break; }
+    }
+    if (!st && count_ < MAX_STATES) {
+        st = &states_[count_++];
+        *st = StateAllocs{stateName, 0, 0, 0};
+    }
+
+    const bool bad = steady && last_ > 0;
+    if (st) {
+        st->frames++;
+        st->allocs += last_;
+        if (bad) st->allocatingSteadyFrames++;
+    }
+    if (bad) violations_++;
+    return bad;
+}
+
+#if FLAPPY_ALLOC_TRACKING
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+namespace {
+    std::atomic<uint64_t> g_count{0};
+    std::atomic<uint64_t> g_bytes{0};
+
+    void* tracked(std::size_t size) {
+        g_count.fetch_add(1, std::memory_order_relaxed);
+        g_bytes.fetch_add(size, std::memory_order_relaxed);
+        return std::malloc(size ? size : 1);
+    }
+
+    void* trackedAligned(std::size_t size, std::size_t align) {
+        g_count.fetch_add(1, std::memory_order_relaxed);
+        g_bytes.fetch_add(size, std::memory_order_relaxed);
+        if (align < sizeof(void*)) align = sizeof(void*);
+        size = (size + align - 1) / align * align;
+        return std::aligned_alloc(align, size ? size : align);
+    }
+}
+
+bool     allocTrackingEnabled() { return true; }
+uint64_t allocCount() { return g_count.load(std::memory_order_relaxed); }
+uint64_t allocBytes() { return g_bytes.load(std::memory_order_relaxed); }
+
+void* operator new(std::size_t size) {
+    if (void* p = tracked(size)) return p;
+    throw std::bad_alloc();
+}
+void* operator new[](std::size_t size) {
+    if (void* p = tracked(size)) return p;
+    throw std::bad_alloc();
+}
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept { return tracked(size); }
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept { return tracked(size); }
+void* operator new(std::size_t size, std::align_val_t al) {
+    if (void* p = trackedAligned(size, (std::size_t)al)) return p;
+    throw std::bad_alloc();
+}
+void* operator new[](std::size_t size, std::align_val_t al) {
+    if (void* p = trackedAligned(size, (std::size_t)al)) return p;
+    throw std::bad_alloc();
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete[](void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::size_t) noexcept { std::free(p); }
+void operator delete(void* p, const std::nothrow_t&) noexcept { std::free(p); }
+void operator delete[](void* p, const std::nothrow_t&) noexcept { std::free(p); }
+void operator delete(void* p, std::align_val_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::align_val_t) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t, std::align_val_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::size_t, std::align_val_t) noexcept { std::free(p); }
+
+#else
+
+bool     allocTrackingEnabled() { return false; }
+uint64_t allocCount() { return 0; }
+uint64_t allocBytes() { return 0; }
+
+#endif
@@ -0,0 +1,46 @@
+#pragma once
+#include <cstdint>
+
+// Contador global de reservas de heap. Con FLAPPY_ALLOC_TRACKING (builds
+// Debug) AllocTracker.cpp sustituye los operator new/delete globales y
+// cuenta cada reserva; sin él no hay hook y allocCount() siempre vale 0.
+bool     allocTrackingEnabled();
+uint64_t allocCount();      // reservas desde el arranque
+uint64_t allocBytes();      // bytes pedidos desde el arranque
+
+// Auditoría por frame y por estado. Un frame es "estable" cuando han pasado
+// warmupFrames desde el último cambio de estado; en esos frames el bucle de
+// juego no debería reservar nada.
+class FrameAllocAudit {
+public:
+    struct StateAllocs {
+        const char* name;
+        long long frames;
+        uint64_t  allocs;
+        long long allocatingSteadyFrames;
+    };
+    static constexpr int MAX_STATES = 8;
+
+    explicit FrameAllocAudit(int warmupFrames) : warmup_(warmupFrames) {}
+
+    void beginFrame() { start_ = allocCount(); }
+
+    // Cierra el frame; devuelve true si era estable y reservó
+    bool endFrame(const char* stateName, bool stateChanged);
+
+    uint64_t lastFrameAllocs() const { return last_; }
+    long long steadyViolations() const { return violations_; }
+
+    int stateCount() const { return count_; }
+    const StateAllocs& state(int i) const { return states_[i]; }
+
+private:
+    int warmup_;
+    int sinceChange_{0};
+    uint64_t start_{0};
+    uint64_t last_{0};
+    long long violations_{0};
+
+    StateAllocs states_[MAX_STATES]{};
+    int count_{0};
+};
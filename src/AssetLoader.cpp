@@ -0,0 +1,111 @@
+#include "AssetLoader.hpp"
+#include "TextureCache.hpp"
+#include "Profiler.hpp"
+#include <algorithm>
+#include <chrono>
+
+AssetLoader::AssetLoader(TextureCache& cache, int workers) : cache_(cache) {
+    if (workers < 1) workers = 1;
+    for (int i = 0; i < workers; i++) threads_.emplace_back(&AssetLoader::workerLoop, this);
+}
+
+AssetLoader::~AssetLoader() {
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stop_ = true;
+    }
+    wake_.notify_all();
+    for (auto& t : threads_) t.join();
+
+    // Lo decodificado que nunca llegó a subirse
+    for (auto& d : decoded_) UnloadImage(d.image);
+}
+
+bool AssetLoader::known(const char* path) const {
+    // Comparaciones contra const char*: preguntar no reserva memoria
+    for (const auto& p : inFlight_) if (p == path) return true;
+    for (const auto& p : failed_)   if (p == path) return true;
+    for (const auto& j : jobs_)     if (j == path) return true;
+    for (const auto& d : decoded_)  if (d.path == path) return true;
+    return false;
+}
+
+bool AssetLoader::failed(const char* path) const {
+    for (const auto& p : failed_) if (p == path) return true;
+    return false;
+}
+
+void AssetLoader::prefetch(const char* path) {
+    if (cache_.resident(path)) return;
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (known(path)) return;
+        jobs_.emplace_back(path);
+    }
+    wake_.notify_one();
+}
+
+bool AssetLoader::isReady(const char* path) const {
+    if (cache_.resident(path)) return true;
+
+    // Si no está pedida (o falló) no se espera por ella: acquire() la
+    // cargará en síncrono como antes
+    std::lock_guard<std::mutex> lock(mutex_);
+    return failed(path) || !known(path);
+}
+
+int AssetLoader::pumpUploads(double budgetMs) {
+    using Clock = std::chrono::steady_clock;
+    const auto start = Clock::now();
+    int uploaded = 0;
+
+    for (;;) {
+        Decoded d;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (decoded_.empty()) break;
+            d = std::move(decoded_.front());
+            decoded_.pop_front();
+        }
+
+        {
+            ProfileScope prof(ProfPhase::TextureLoad);
+            Texture2D tex = LoadTextureFromImage(d.image);
+            UnloadImage(d.image);
+            cache_.adopt(d.path.c_str(), tex, std::move(d.mask));
+        }
+        uploaded++;
+
+        const double ms = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+        if (ms >= budgetMs) break;
+    }
+    return uploaded;
+}
+
+int AssetLoader::pending() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return (int)(jobs_.size() + inFlight_.size() + decoded_.size());
+}
+
+void AssetLoader::workerLoop() {
+    for (;;) {
+        std::string path;
+        {
+            std::unique_lock<std::mutex> lock(mutex_);
+            wake_.wait(lock, [this] { return stop_ || !jobs_.empty(); });
+            if (stop_) return;
+            path = std::move(jobs_.front());
+            jobs_.pop_front();
+            inFlight_.push_back(path);
+        }
+
+        // Solo CPU: lectura de fichero, decodificación del PNG y máscara
+        Image img = LoadImage(path.c_str());
+        CollisionMask mask = TextureCache::buildMask(img);
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        inFlight_.erase(std::find(inFlight_.begin(), inFlight_.end(), path));
+        if (img.data) decoded_.push_back(Decoded{path, img, std::move(mask)});
+        else          failed_.push_back(path);
+    }
+}
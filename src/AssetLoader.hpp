@@ -0,0 +1,64 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "StateMachine.hpp"
+#include "CollisionMask.hpp"
+
+extern "C" {
+    #include <raylib.h>
+}
+
+class TextureCache;
+
+// Precarga asíncrona de texturas. La decodificación del PNG (LoadImage) va
+// en hilos de fondo; la subida a GPU (LoadTextureFromImage) tiene que ser en
+// el hilo principal, así que pumpUploads() la reparte entre frames con un
+// presupuesto de tiempo. Lo subido entra en la TextureCache con su máscara
+// de colisión, y desde ahí ni acquire() ni mask() tocan disco.
+class AssetLoader : public AssetProvider {
+public:
+    AssetLoader(TextureCache& cache, int workers);
+    ~AssetLoader();
+
+    AssetLoader(const AssetLoader&) = delete;
+    AssetLoader& operator=(const AssetLoader&) = delete;
+
+    // AssetProvider
+    void prefetch(const char* path) override;
+    bool isReady(const char* path) const override;
+
+    // Hilo principal: sube imágenes decodificadas hasta agotar budgetMs
+    // (al menos una por llamada si hay alguna lista). Devuelve cuántas subió.
+    int pumpUploads(double budgetMs);
+
+    int pending() const;   // en cola o decodificadas sin subir
+
+private:
+    struct Decoded {
+        std::string path;
+        Image image;
+        CollisionMask mask;   // hecha en el hilo, con los mismos píxeles
+    };
+
+    void workerLoop();
+    bool known(const char* path) const;    // con mutex_ tomado
+    bool failed(const char* path) const;   // con mutex_ tomado
+
+    TextureCache& cache_;
+
+    mutable std::mutex mutex_;
+    std::condition_variable wake_;
+    std::deque<std::string> jobs_;          // rutas por decodificar
+    std::deque<Decoded> decoded_;           // listas para subir
+    std::vector<std::string> inFlight_;     // decodificándose ahora mismo
+    std::vector<std::string> failed_;       // no se pudieron leer (no bloquean)
+    bool stop_{false};
+
+    std::vector<std::thread> threads_;
+};
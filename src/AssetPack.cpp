@@ -0,0 +1,162 @@
+#include "AssetPack.hpp"
+#include <cstdio>
+#include <cstring>
+
+#include <sys/stat.h>
+#if !defined(_WIN32)
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <unistd.h>
+#endif
+
+namespace {
+    const char MAGIC[4] = {'F', 'B', 'P', 'K'};
+    const size_t HEADER_BYTES = 16;
+    const size_t ENTRY_BYTES  = AssetPack::PATH_BYTES + 8 + 16;
+    const size_t PIXEL_ALIGN  = 64;
+
+    uint16_t getU16(const uint8_t* p) { return (uint16_t)(p[0] | (p[1] << 8)); }
+    uint32_t getU32(const uint8_t* p) { return (uint32_t)getU16(p) | ((uint32_t)getU16(p + 2) << 16); }
+    void putU16(uint8_t* p, uint16_t v) { p[0] = (uint8_t)v; p[1] = (uint8_t)(v >> 8); }
+    void putU32(uint8_t* p, uint32_t v) { putU16(p, (uint16_t)v); putU16(p + 2, (uint16_t)(v >> 16)); }
+    uint64_t getU64(const uint8_t* p) { return (uint64_t)getU32(p) | ((uint64_t)getU32(p + 4) << 32); }
+    void putU64(uint8_t* p, uint64_t v) { putU32(p, (uint32_t)v); putU32(p + 4, (uint32_t)(v >> 32)); }
+}
+
+bool AssetPack::sourceStamp(const char* path, uint64_t& mtimeNs, uint64_t& size) {
+#if defined(_WIN32)
+    struct _stat64 st;
+    if (_stat64(path, &st) != 0) return false;
+    mtimeNs = (uint64_t)st.st_mtime * 1000000000ull;
+#else
+    struct stat st;
+    if (::stat(path, &st) != 0) return false;
+    #if defined(__APPLE__)
+        mtimeNs = (uint64_t)st.st_mtimespec.tv_sec * 1000000000ull + (uint64_t)st.st_mtimespec.tv_nsec;
+    #else
+        mtimeNs = (uint64_t)st.st_mtim.tv_sec * 1000000000ull + (uint64_t)st.st_mtim.tv_nsec;
+    #endif
+#endif
+    size = (uint64_t)st.st_size;
+    return true;
+}
+
+bool AssetPack::upToDate(const Entry& entry) {
+    uint64_t mtime, size;
+    if (!sourceStamp(entry.path.c_str(), mtime, size)) return true;
+    return mtime == entry.sourceMtimeNs && size == entry.sourceSize;
+}
+
+AssetPack::~AssetPack() {
+    close();
+}
+
+bool AssetPack::open(const char* path) {
+    close();
+
+#if !defined(_WIN32)
+    // Mapeado: los píxeles van de la caché de páginas a la GPU sin copia
+    // intermedia en el heap
+    const int fd = ::open(path, O_RDONLY);
+    if (fd < 0) return false;
+    struct stat st;
+    if (fstat(fd, &st) == 0 && st.st_size > 0) {
+        void* m = mmap(nullptr, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (m != MAP_FAILED) {
+            map_ = static_cast<const uint8_t*>(m);
+            mapSize_ = (size_t)st.st_size;
+        }
+    }
+    ::close(fd);
+#else
+    if (FILE* in = std::fopen(path, "rb")) {
+        uint8_t chunk[64 * 1024];
+        size_t n;
+        while ((n = std::fread(chunk, 1, sizeof(chunk), in)) > 0) fallback_.insert(fallback_.end(), chunk, chunk + n);
+        std::fclose(in);
+        map_ = fallback_.data();
+        mapSize_ = fallback_.size();
+    }
+#endif
+    if (!map_) return false;
+
+    // Cabecera e índice se validan contra el tamaño real antes de fiarse
+    if (mapSize_ < HEADER_BYTES || std::memcmp(map_, MAGIC, 4) != 0 || getU16(map_ + 4) != VERSION) {
+        close();
+        return false;
+    }
+    const int count    = getU16(map_ + 6);
+    width_             = getU16(map_ + 8);
+    height_            = getU16(map_ + 10);
+    const size_t pixelsAt = getU32(map_ + 12);
+    const size_t pixelBytes = (size_t)width_ * height_ * 4;
+    if (HEADER_BYTES + count * ENTRY_BYTES > pixelsAt || pixelsAt + pixelBytes > mapSize_) {
+        close();
+        return false;
+    }
+
+    entries_.reserve(count);
+    for (int i = 0; i < count; i++) {
+        const uint8_t* e = map_ + HEADER_BYTES + i * ENTRY_BYTES;
+        const char* name = reinterpret_cast<const char*>(e);
+        Entry entry{ std::string(name, strnlen(name, PATH_BYTES)),
+                     getU16(e + PATH_BYTES), getU16(e + PATH_BYTES + 2),
+                     getU16(e + PATH_BYTES + 4), getU16(e + PATH_BYTES + 6),
+                     getU64(e + PATH_BYTES + 8), getU64(e + PATH_BYTES + 16) };
+        if (entry.x + entry.width > width_ || entry.y + entry.height > height_) {
+            close();
+            return false;
+        }
+        entries_.push_back(std::move(entry));
+    }
+    pixels_ = map_ + pixelsAt;
+    return true;
+}
+
+void AssetPack::close() {
+#if !defined(_WIN32)
+    if (map_) munmap(const_cast<uint8_t*>(map_), mapSize_);
+#endif
+    map_ = nullptr;
+    mapSize_ = 0;
+    fallback_.clear();
+    fallback_.shrink_to_fit();
+    pixels_ = nullptr;
+    width_ = height_ = 0;
+    entries_.clear();
+}
+
+bool writeAssetPack(const char* path, int width, int height, const uint8_t* rgba,
+                    const std::vector<AssetPack::Entry>& entries) {
+    if (width > 0xFFFF || height > 0xFFFF || entries.size() > 0xFFFF) return false;
+
+    const size_t indexEnd = HEADER_BYTES + entries.size() * ENTRY_BYTES;
+    const size_t pixelsAt = (indexEnd + PIXEL_ALIGN - 1) / PIXEL_ALIGN * PIXEL_ALIGN;
+    std::vector<uint8_t> head(pixelsAt, 0);
+
+    std::memcpy(head.data(), MAGIC, 4);
+    putU16(&head[4], AssetPack::VERSION);
+    putU16(&head[6], (uint16_t)entries.size());
+    putU16(&head[8], (uint16_t)width);
+    putU16(&head[10], (uint16_t)height);
+    putU32(&head[12], (uint32_t)pixelsAt);
+    for (size_t i = 0; i < entries.size(); i++) {
+        const AssetPack::Entry& e = entries[i];
+        if (e.path.size() >= (size_t)AssetPack::PATH_BYTES) return false;
+        uint8_t* out = &head[HEADER_BYTES + i * ENTRY_BYTES];
+        std::memcpy(out, e.path.data(), e.path.size());
+        putU16(out + AssetPack::PATH_BYTES,     (uint16_t)e.x);
+        putU16(out + AssetPack::PATH_BYTES + 2, (uint16_t)e.y);
+        putU16(out + AssetPack::PATH_BYTES + 4, (uint16_t)e.width);
+        putU16(out + AssetPack::PATH_BYTES + 6, (uint16_t)e.height);
+        putU64(out + AssetPack::PATH_BYTES + 8, e.sourceMtimeNs);
+        putU64(out + AssetPack::PATH_BYTES + 16, e.sourceSize);
+    }
+
+    FILE* out = std::fopen(path, "wb");
+    if (!out) return false;
+    const size_t pixelBytes = (size_t)width * height * 4;
+    const bool ok = std::fwrite(head.data(), 1, head.size(), out) == head.size() &&
+                    std::fwrite(rgba, 1, pixelBytes, out) == pixelBytes;
+    return std::fclose(out) == 0 && ok;
+}
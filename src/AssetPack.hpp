@@ -0,0 +1,67 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Pack de assets ya decodificados: todos los PNG en un atlas RGBA8 crudo y
+// un índice de rectángulos por ruta. Lo genera tools/packer; el juego lo
+// mapea en memoria y lo sube con una sola textura (TextureCache::loadPack).
+//
+// Formato (.fbpak, little-endian):
+//   cabecera  "FBPK", u16 versión, u16 entradas, u16 ancho, u16 alto,
+//             u32 desplazamiento de los píxeles
+//   índice    por entrada: ruta (PATH_BYTES, terminada en 0), u16 x, y, w, h,
+//             u64 mtime del PNG (ns), u64 tamaño del PNG
+//   píxeles   ancho*alto*4 bytes RGBA, fila a fila, alineados a 64 bytes
+//
+// mtime y tamaño son los del PNG al empaquetar: si el PNG cambió después,
+// la entrada está desactualizada (upToDate) y el juego usa el PNG.
+class AssetPack {
+public:
+    static constexpr uint16_t VERSION = 2;
+    static constexpr int PATH_BYTES = 48;
+
+    struct Entry {
+        std::string path;   // tal cual la pide acquire(), p. ej. "assets/base.png"
+        int x, y, width, height;
+        uint64_t sourceMtimeNs{0};   // del PNG de origen (sourceStamp)
+        uint64_t sourceSize{0};
+    };
+
+    // mtime (ns si el sistema lo da) y tamaño de un fichero; false si no está
+    static bool sourceStamp(const char* path, uint64_t& mtimeNs, uint64_t& size);
+
+    // ¿El PNG de la entrada sigue siendo el que se empaquetó? Solo un stat,
+    // sin leerlo. Sin el PNG (distribución solo con el pack) vale el pack.
+    static bool upToDate(const Entry& entry);
+
+    AssetPack() = default;
+    ~AssetPack();
+
+    AssetPack(const AssetPack&) = delete;
+    AssetPack& operator=(const AssetPack&) = delete;
+
+    bool open(const char* path);   // false si no existe o no es un pack válido
+    void close();
+    bool isOpen() const { return pixels_ != nullptr; }
+
+    int width() const { return width_; }
+    int height() const { return height_; }
+    const uint8_t* pixels() const { return pixels_; }   // válidos mientras siga abierto
+
+    const std::vector<Entry>& entries() const { return entries_; }
+
+private:
+    const uint8_t* map_{nullptr};   // fichero entero (mmap o, sin él, leído)
+    size_t mapSize_{0};
+    std::vector<uint8_t> fallback_;
+    const uint8_t* pixels_{nullptr};
+    int width_{0};
+    int height_{0};
+    std::vector<Entry> entries_;
+};
+
+// Lo usa el packer: escribe el atlas (width*height*4 bytes) y su índice
+bool writeAssetPack(const char* path, int width, int height, const uint8_t* rgba,
+                    const std::vector<AssetPack::Entry>& entries);
@@ -0,0 +1,178 @@
+#include "Autopilot.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+#if defined(__SSE2__)
+    #include <emmintrin.h>
+    #define AUTOPILOT_SIMD 1
+#else
+    #define AUTOPILOT_SIMD 0
+#endif
+
+namespace {
+    const char* const MAGIC = "autopilot";
+    const int VERSION = 1;
+    const float VY_CLAMP = 4.0f;
+
+    // Primera capa con el hueco ya aplicado: por neurona, k + m·y + v·vy'
+    // (vy' = vy normalizada y acotada)
+    struct Folded {
+        float k[Autopilot::HIDDEN];
+        float m[Autopilot::HIDDEN];
+        float v[Autopilot::HIDDEN];
+    };
+
+    Folded fold(const Autopilot::Weights& w, const WorldParams& params, const Autopilot::Gap& gap) {
+        const float invGap = 1.0f / gapFor(params);
+        const float h = (float)params.birdH;
+        Folded f;
+        for (int j = 0; j < Autopilot::HIDDEN; j++) {
+            const float* wj = w.w1[j];
+            f.k[j] = w.b1[j] + wj[0] * gap.dx
+                   - wj[1] * gap.top * invGap
+                   + wj[2] * (gap.bottom - h) * invGap;
+            f.m[j] = (wj[1] - wj[2]) * invGap;
+            f.v[j] = wj[3];
+        }
+        return f;
+    }
+
+    void decideScalar(int begin, int end, const Folded& f, const Autopilot::Weights& w,
+                      float invFall, const float* y, const float* vy, uint8_t* flaps) {
+        for (int i = begin; i < end; i++) {
+            const float v = std::min(VY_CLAMP, std::max(-VY_CLAMP, vy[i] * invFall));
+            float out = w.b2;
+            for (int j = 0; j < Autopilot::HIDDEN; j++) {
+                const float a = f.k[j] + f.m[j] * y[i] + f.v[j] * v;
+                out += w.w2[j] * std::max(a, 0.0f);
+            }
+            flaps[i] = out > 0.0f;
+        }
+    }
+
+#if AUTOPILOT_SIMD
+    // Mismas operaciones y en el mismo orden que decideScalar: un pájaro
+    // decide lo mismo en un lote que solo
+    void decideSimd(int n4, const Folded& f, const Autopilot::Weights& w,
+                    float invFall, const float* y, const float* vy, uint8_t* flaps) {
+        const __m128 vInvFall = _mm_set1_ps(invFall);
+        const __m128 vLo      = _mm_set1_ps(-VY_CLAMP);
+        const __m128 vHi      = _mm_set1_ps(VY_CLAMP);
+        const __m128 vZero    = _mm_setzero_ps();
+        const __m128 vB2      = _mm_set1_ps(w.b2);
+
+        for (int i = 0; i < n4; i += 4) {
+            const __m128 py = _mm_loadu_ps(y + i);
+            const __m128 pv = _mm_min_ps(vHi, _mm_max_ps(vLo, _mm_mul_ps(_mm_loadu_ps(vy + i), vInvFall)));
+            __m128 out = vB2;
+            for (int j = 0; j < Autopilot::HIDDEN; j++) {
+                __m128 a = _mm_add_ps(_mm_add_ps(_mm_set1_ps(f.k[j]), _mm_mul_ps(_mm_set1_ps(f.m[j]), py)),
+                                      _mm_mul_ps(_mm_set1_ps(f.v[j]), pv));
+                out = _mm_add_ps(out, _mm_mul_ps(_mm_set1_ps(w.w2[j]), _mm_max_ps(a, vZero)));
+            }
+            // 4 máscaras de 32 bits → 4 bytes 0/1
+            const int bits = _mm_movemask_ps(_mm_cmpgt_ps(out, vZero));
+            flaps[i]     = (uint8_t)(bits & 1);
+            flaps[i + 1] = (uint8_t)((bits >> 1) & 1);
+            flaps[i + 2] = (uint8_t)((bits >> 2) & 1);
+            flaps[i + 3] = (uint8_t)((bits >> 3) & 1);
+        }
+    }
+#endif
+}
+
+Autopilot::Gap Autopilot::nearestGap(const WorldParams& params, const PipeField& pipes, float birdX) {
+    Gap gap;
+    gap.top = 0.0f;
+    gap.bottom = params.screenH - params.groundH;
+    for (int i = 0; i < pipes.count(); i++) {
+        const PipePair& p = pipes[i];
+        const float end = pipes.x(p) + params.pipeW;
+        if (end >= birdX) {
+            gap.dx = (end - birdX) / params.screenW;
+            gap.top = p.topY + params.pipeH;
+            gap.bottom = p.botY;
+            break;
+        }
+    }
+    return gap;
+}
+
+bool Autopilot::decide(const World& world) const {
+    const Bird& b = world.bird();
+    const Gap gap = nearestGap(world.params(), world.pipes(), b.x);
+    uint8_t flap = 0;
+    decide(world.params(), gap, &b.y, &b.vy, 1, &flap);
+    return flap != 0;
+}
+
+void Autopilot::decide(const WorldParams& params, const Gap& gap,
+                       const float* y, const float* vy, int n, uint8_t* flaps) const {
+    const Folded f = fold(w_, params, gap);
+    const float invFall = 1.0f / tickVelocity(params, 1.0f, false);
+
+    const int n4 = AUTOPILOT_SIMD ? (n & ~3) : 0;
+#if AUTOPILOT_SIMD
+    decideSimd(n4, f, w_, invFall, y, vy, flaps);
+#endif
+    decideScalar(n4, n, f, w_, invFall, y, vy, flaps);
+}
+
+// --- Fichero de pesos
+
+bool Autopilot::load(const char* path) {
+    FILE* f = std::fopen(path, "rb");
+    if (!f) return false;
+    std::string text;
+    char line[512];
+    while (std::fgets(line, sizeof(line), f)) {
+        char* hash = std::strchr(line, '#');
+        if (hash) *hash = '\0';
+        text += line;
+        text += ' ';
+    }
+    std::fclose(f);
+
+    // Cabecera y después exactamente los números que caben en Weights
+    char magic[16] = {};
+    int version = 0, inputs = 0, hidden = 0, used = 0;
+    if (std::sscanf(text.c_str(), "%15s %d %d %d%n", magic, &version, &inputs, &hidden, &used) != 4 ||
+        std::strcmp(magic, MAGIC) != 0 || version != VERSION || inputs != INPUTS || hidden != HIDDEN) {
+        return false;
+    }
+    const char* p = text.c_str() + used;
+    Weights w;
+    auto next = [&p](float& out) {
+        char* end;
+        out = std::strtof(p, &end);
+        if (end == p) return false;
+        p = end;
+        return true;
+    };
+    for (int j = 0; j < HIDDEN; j++) {
+        for (int i = 0; i < INPUTS; i++) if (!next(w.w1[j][i])) return false;
+        if (!next(w.b1[j]) || !next(w.w2[j])) return false;
+    }
+    if (!next(w.b2)) return false;
+    while (*p == ' ' || *p == '\n' || *p == '\r' || *p == '\t') p++;
+    if (*p) return false;   // sobra algo: otro tamaño de red
+    w_ = w;
+    return true;
+}
+
+bool Autopilot::save(const char* path) const {
+    FILE* f = std::fopen(path, "wb");
+    if (!f) return false;
+    std::fprintf(f, "# Piloto automático (src/Autopilot.hpp): MLP %d-%d-1 con ReLU\n", INPUTS, HIDDEN);
+    std::fprintf(f, "# por neurona oculta: pesos de dx, y-arriba, abajo-y, vy; sesgo; peso de salida\n");
+    std::fprintf(f, "%s %d %d %d\n", MAGIC, VERSION, INPUTS, HIDDEN);
+    for (int j = 0; j < HIDDEN; j++) {
+        for (int i = 0; i < INPUTS; i++) std::fprintf(f, "%.9g ", w_.w1[j][i]);
+        std::fprintf(f, "  %.9g   %.9g\n", w_.b1[j], w_.w2[j]);
+    }
+    std::fprintf(f, "%.9g\n", w_.b2);
+    return std::fclose(f) == 0;
+}
@@ -0,0 +1,60 @@
+#pragma once
+#include <cstdint>
+#include "World.hpp"
+
+// Piloto automático: una política pequeña (MLP 4-8-1 con ReLU) que decide
+// si saltar a partir del hueco más cercano. Sirve para el modo demo y para
+// pruebas largas sin nadie al teclado (--autopilot), y por lotes para
+// entrenar o simular muchos pájaros (tools/train con un Flock).
+//
+// Entradas, relativas al pájaro y normalizadas:
+//   0  distancia en x hasta el final de la pareja más cercana / screenW
+//   1  (y - borde superior del hueco) / hueco
+//   2  (borde inferior del hueco - (y + h)) / hueco
+//   3  vy / velocidad de caída (acotada a ±4: > 0 cae, < 0 acaba de saltar)
+// Salida > 0 → salto.
+//
+// Todos los pájaros de un tick ven el mismo hueco, así que lo común a todos
+// se pliega en la primera capa (Gap + fold) y por pájaro solo queda
+// k + m·y + w·vy por neurona: sin reservas, tamaño fijo, SSE2 de 4 en 4.
+class Autopilot {
+public:
+    static constexpr int INPUTS = 4;
+    static constexpr int HIDDEN = 8;
+
+    struct Weights {
+        float w1[HIDDEN][INPUTS]{};
+        float b1[HIDDEN]{};
+        float w2[HIDDEN]{};
+        float b2{0.0f};
+    };
+
+    // Fichero de texto: "autopilot 1 4 8" y luego, por neurona oculta, sus
+    // INPUTS pesos, su sesgo y su peso de salida; al final el sesgo de
+    // salida. Las líneas con # son comentarios.
+    bool load(const char* path);
+    bool save(const char* path) const;
+
+    const Weights& weights() const { return w_; }
+    void setWeights(const Weights& w) { w_ = w; }
+
+    // Lo común a todos los pájaros de un tick: el hueco de la primera pareja
+    // que aún no han pasado (sin ninguna, todo el alto de juego)
+    struct Gap {
+        float dx{1.0f};       // ya normalizada (entrada 0)
+        float top{0.0f};      // y del borde superior del hueco
+        float bottom{0.0f};   // y del borde inferior
+    };
+    static Gap nearestGap(const WorldParams& params, const PipeField& pipes, float birdX);
+
+    // Un pájaro (MainGameState): lote de 1
+    bool decide(const World& world) const;
+
+    // Por lotes: flaps[i] = 1 si el pájaro i (y[i], vy[i]) salta. Sin
+    // reservas; los arrays SoA de Flock sirven tal cual.
+    void decide(const WorldParams& params, const Gap& gap,
+                const float* y, const float* vy, int n, uint8_t* flaps) const;
+
+private:
+    Weights w_{};
+};
@@ -0,0 +1,71 @@
+#include "CollisionMask.hpp"
+#include <algorithm>
+
+namespace {
+    // 64 columnas de una fila empezando en la columna `from` (puede ser
+    // negativa o pasarse del ancho: fuera de la máscara todo es 0)
+    inline uint64_t bitsAt(const uint64_t* row, int words, int from) {
+        if (from <= -64) return 0;
+        if (from < 0) return bitsAt(row, words, 0) << (-from);
+        const int w = from >> 6;
+        const int s = from & 63;
+        if (w >= words) return 0;
+        uint64_t v = row[w] >> s;
+        if (s && w + 1 < words) v |= row[w + 1] << (64 - s);
+        return v;
+    }
+}
+
+void CollisionMask::resize(int width, int height) {
+    width_  = std::max(0, width);
+    height_ = std::max(0, height);
+    words_  = (width_ + 63) / 64;
+    bits_.assign((size_t)words_ * height_, 0);
+}
+
+void CollisionMask::build(const uint8_t* rgba, int width, int height, int stride, uint8_t threshold) {
+    resize(width, height);
+    if (stride <= 0) stride = width_ * 4;
+    for (int y = 0; y < height_; y++) {
+        uint64_t* r = row(y);
+        const uint8_t* px = rgba + (size_t)y * stride;
+        for (int x = 0; x < width_; x++) {
+            if (px[x * 4 + 3] >= threshold) r[x >> 6] |= 1ull << (x & 63);
+        }
+    }
+}
+
+CollisionMask CollisionMask::rotated180() const {
+    CollisionMask out;
+    out.resize(width_, height_);
+    for (int y = 0; y < height_; y++) {
+        for (int x = 0; x < width_; x++) {
+            if (bit(x, y)) {
+                const int rx = width_ - 1 - x;
+                out.row(height_ - 1 - y)[rx >> 6] |= 1ull << (rx & 63);
+            }
+        }
+    }
+    return out;
+}
+
+bool masksOverlap(const CollisionMask& a, const CollisionMask& b, int dx, int dy) {
+    // Filas y columnas comunes (en coordenadas de a)
+    const int y0 = std::max(0, dy);
+    const int y1 = std::min(a.height(), dy + b.height());
+    const int x0 = std::max(0, dx);
+    const int x1 = std::min(a.width(), dx + b.width());
+    if (y0 >= y1 || x0 >= x1) return false;
+
+    const int w0 = x0 >> 6;
+    const int w1 = (x1 + 63) >> 6;
+    for (int y = y0; y < y1; y++) {
+        const uint64_t* ra = a.row(y);
+        const uint64_t* rb = b.row(y - dy);
+        for (int w = w0; w < w1; w++) {
+            // Columna 64*w de a = columna 64*w - dx de b
+            if (ra[w] & bitsAt(rb, b.words(), w * 64 - dx)) return true;
+        }
+    }
+    return false;
+}
@@ -0,0 +1,56 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Máscara de colisión de 1 bit por píxel (alfa por encima de un umbral),
+// fila a fila en palabras de 64 bits: bit j de la palabra i = columna
+// 64*i + j. Los bits de relleno tras la última columna son 0.
+class CollisionMask {
+public:
+    static constexpr uint8_t ALPHA_THRESHOLD = 128;
+
+    // Desde píxeles RGBA8; stride en bytes entre filas (0 = width*4, sin
+    // relleno; el de un atlas cuando el sprite es un trozo de él)
+    void build(const uint8_t* rgba, int width, int height, int stride = 0,
+               uint8_t threshold = ALPHA_THRESHOLD);
+    void resize(int width, int height);   // todo a 0
+
+    CollisionMask rotated180() const;     // la tubería de arriba se dibuja girada
+
+    bool empty() const { return width_ == 0 || height_ == 0; }
+    int width() const { return width_; }
+    int height() const { return height_; }
+    int words() const { return words_; }  // palabras por fila
+
+    const uint64_t* row(int y) const { return &bits_[(size_t)y * words_]; }
+    uint64_t* row(int y) { return &bits_[(size_t)y * words_]; }
+    bool bit(int x, int y) const { return (row(y)[x >> 6] >> (x & 63)) & 1u; }
+
+private:
+    int width_{0};
+    int height_{0};
+    int words_{0};
+    std::vector<uint64_t> bits_;
+};
+
+// Fase estrecha: ¿se tocan píxeles opacos de a y b con b desplazada
+// (dx, dy) píxeles respecto a a? Recorre solo las filas comunes y hace un
+// AND de 64 columnas por palabra; para el pájaro (34 px) es una palabra por
+// fila.
+bool masksOverlap(const CollisionMask& a, const CollisionMask& b, int dx, int dy);
+
+// Máscaras que usa World para la colisión exacta. Son punteros: las
+// máscaras viven fuera (caché de texturas, repetición...).
+struct CollisionMasks {
+    const CollisionMask* bird[3]{};      // por frame de aleteo (0 down, 1 mid, 2 up)
+    const CollisionMask* pipe[2]{};      // [verde, roja], la de abajo
+    const CollisionMask* pipeTop[2]{};   // las mismas giradas 180º
+
+    bool valid() const {
+        for (auto* m : bird)    if (!m || m->empty()) return false;
+        for (auto* m : pipe)    if (!m || m->empty()) return false;
+        for (auto* m : pipeTop) if (!m || m->empty()) return false;
+        return true;
+    }
+};
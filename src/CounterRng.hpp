@@ -0,0 +1,31 @@
+#pragma once
+#include <cstdint>
+
+// Aleatorio basado en contador: el valor k de un flujo es una función pura
+// de (semilla, flujo, k), sin estado que avanzar. Cada mundo tiene su
+// semilla (nada global, se pueden simular mundos en paralelo) y cualquier
+// valor se obtiene en O(1) sin generar los anteriores.
+//
+// Es el finalizador de splitmix64 sobre (semilla, flujo, k): pasa las
+// pruebas habituales de aleatoriedad para este uso y cuesta unas pocas
+// multiplicaciones.
+enum class RngStream : uint32_t {
+    PipeGap   = 0,   // centro del hueco de la tubería k
+    PipeColor = 1,   // color de la tubería k
+    Cosmetic  = 2,   // fondo, color del pájaro... (k = qué cosa)
+    Tools     = 3,   // jugadores simulados de las herramientas (tools/ReferencePlayer.hpp)
+};
+
+inline uint64_t counterRng(uint32_t seed, RngStream stream, uint32_t k) {
+    uint64_t z = ((uint64_t)seed << 32 | k) + (uint64_t)((uint32_t)stream + 1) * 0x9E3779B97F4A7C15ull;
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    return z ^ (z >> 31);
+}
+
+// Entero en [min, max], como GetRandomValue
+inline int counterInt(uint32_t seed, RngStream stream, uint32_t k, int min, int max) {
+    if (max < min) { int t = min; min = max; max = t; }
+    const uint64_t span = (uint64_t)((int64_t)max - (int64_t)min + 1);
+    return min + (int)(counterRng(seed, stream, k) % span);
+}
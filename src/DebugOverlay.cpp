@@ -0,0 +1,41 @@
+extern "C" {
+    #include <raylib.h>
+}
+#include "DebugOverlay.hpp"
+#include "Profiler.hpp"
+
+namespace {
+    const int WINDOW = 240;   // frames que entran en los percentiles
+    const int FONT   = 10;
+    const int LINE_H = 12;
+}
+
+void drawProfilerOverlay(const Profiler& prof) {
+    const int rows = Profiler::PHASES + 3;
+    DrawRectangle(4, 4, 212, rows * LINE_H + 8, Fade(BLACK, 0.7f));
+
+    int y = 8;
+    DrawText("fase            p50    p99    max (ms)", 8, y, FONT, YELLOW);
+    y += LINE_H;
+
+    for (int i = 0; i < Profiler::PHASES; i++) {
+        Profiler::Stats s = prof.stats((ProfPhase)i, WINDOW);
+        DrawText(TextFormat("%-14s %6.2f %6.2f %6.2f", profPhaseName((ProfPhase)i),
+                            s.p50 * 1e-3f, s.p99 * 1e-3f, s.max * 1e-3f), 8, y, FONT, RAYWHITE);
+        y += LINE_H;
+    }
+
+    Profiler::Stats f = prof.frameStats(WINDOW);
+    DrawText(TextFormat("%-14s %6.2f %6.2f %6.2f", "frame",
+                        f.p50 * 1e-3f, f.p99 * 1e-3f, f.max * 1e-3f), 8, y, FONT, GREEN);
+    y += LINE_H;
+
+    // Contadores del último frame completo
+    if (prof.frameCount() > 0) {
+        const Profiler::Frame& last = prof.frame(prof.frameCount() - 1);
+        DrawText(TextFormat("quads %u  draws %u  tex switches %u",
+                            last.counters[(int)ProfCounter::Quads],
+                            last.counters[(int)ProfCounter::DrawCalls],
+                            last.counters[(int)ProfCounter::TextureSwitches]), 8, y, FONT, SKYBLUE);
+    }
+}
@@ -0,0 +1,6 @@
+#pragma once
+class Profiler;
+
+// Panel F3: p50/p99/max por fase de los últimos frames (dibujar dentro de
+// BeginDrawing/EndDrawing, encima de todo)
+void drawProfilerOverlay(const Profiler& prof);
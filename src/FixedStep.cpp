@@ -0,0 +1,29 @@
+#include "FixedStep.hpp"
+
+FixedStep::FixedStep(double hz, int maxSteps)
+: step_(hz > 0.0 ? 1.0 / hz : 1.0 / 240.0), maxSteps_(maxSteps > 0 ? maxSteps : 1) {}
+
+int FixedStep::advance(double frameDt) {
+    if (frameDt > 0.0) acc_ += frameDt;
+
+    int steps = 0;
+    while (acc_ >= step_ && steps < maxSteps_) {
+        acc_ -= step_;
+        steps++;
+    }
+
+    // Tope de pasos alcanzado: tirar el atraso en vez de entrar en espiral
+    if (acc_ >= step_) {
+        double keep = acc_ - step_ * (long long)(acc_ / step_);
+        dropped_ += acc_ - keep;
+        acc_ = keep;
+    }
+
+    lastSteps_ = steps;
+    totalSteps_ += steps;
+    return steps;
+}
+
+void FixedStep::reset() {
+    acc_ = 0.0;
+}
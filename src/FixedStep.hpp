@@ -0,0 +1,36 @@
+#pragma once
+
+// Acumulador de paso fijo: convierte el tiempo real de cada frame en un
+// número entero de pasos de simulación de duración constante. Lo que sobra
+// se queda en el acumulador y alpha() dice cuánto del siguiente paso ya ha
+// pasado, para interpolar el render entre los dos últimos estados.
+class FixedStep {
+public:
+    FixedStep(double hz, int maxSteps);
+
+    // Suma frameDt y devuelve cuántos pasos hay que simular este frame
+    // (como mucho maxSteps; el tiempo que no cabe se descarta).
+    int advance(double frameDt);
+
+    void reset();   // vacía el acumulador (p. ej. tras una transición)
+
+    float dt() const { return (float)step_; }
+    float alpha() const { return (float)(acc_ / step_); }
+    // Tiempo real que aún no se ha simulado (lo que queda en el acumulador):
+    // el último paso de advance() acaba lag() segundos antes de ahora
+    double lag() const { return acc_; }
+
+    // Métricas
+    int       lastSteps() const { return lastSteps_; }
+    long long totalSteps() const { return totalSteps_; }
+    double    droppedTime() const { return dropped_; }
+
+private:
+    double step_;
+    int    maxSteps_;
+    double acc_{0.0};
+
+    int       lastSteps_{0};
+    long long totalSteps_{0};
+    double    dropped_{0.0};
+};
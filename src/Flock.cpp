@@ -0,0 +1,187 @@
+#include "Flock.hpp"
+#include <algorithm>
+#include <cstring>
+
+#if defined(__SSE2__)
+    #include <emmintrin.h>
+    #define FLOCK_SIMD 1
+#else
+    #define FLOCK_SIMD 0
+#endif
+
+namespace {
+    // Banda vertical [top, bottom) que mata al pájaro (cuerpo de una tubería)
+    struct Band { float top; float bottom; };
+
+    // Física + techo/suelo, escalar (cola del array o sin SSE)
+    // fall/jump: velocidades del tick según tickVelocity (World.hpp)
+    void integrateScalar(int begin, int end, const uint8_t* flaps,
+                         float* y, float* vy, uint32_t* alive,
+                         float jump, float fall, float dt, float h, float floorY) {
+        for (int i = begin; i < end; i++) {
+            if (!alive[i]) continue;
+            vy[i] = fall + (flaps[i] ? jump : 0.0f);
+            y[i] += vy[i] * dt;
+            if (y[i] < 0 || y[i] + h > floorY) alive[i] = 0;
+        }
+    }
+
+    // score = vivo ? passed : score
+    void scoreScalar(int begin, int end, const uint32_t* alive, int32_t* score, int32_t passed) {
+        for (int i = begin; i < end; i++) if (alive[i]) score[i] = passed;
+    }
+
+    // Test en y contra las bandas de las tuberías candidatas (AABB estricto
+    // como CheckCollisionRecs; el solape en x ya lo ha dado el broad phase)
+    void hitScalar(int begin, int end, const float* y, uint32_t* alive,
+                   float h, const Band* bands, int nBands) {
+        for (int i = begin; i < end; i++) {
+            if (!alive[i]) continue;
+            for (int b = 0; b < nBands; b++) {
+                if (y[i] < bands[b].bottom && y[i] + h > bands[b].top) { alive[i] = 0; break; }
+            }
+        }
+    }
+
+#if FLOCK_SIMD
+    void integrateSimd(int n4, const uint8_t* flaps,
+                       float* y, float* vy, uint32_t* alive,
+                       float jump, float fall, float dt, float h, float floorY) {
+        const __m128 vJump  = _mm_set1_ps(jump);
+        const __m128 vFall  = _mm_set1_ps(fall);
+        const __m128 vDt    = _mm_set1_ps(dt);
+        const __m128 vH     = _mm_set1_ps(h);
+        const __m128 vFloor = _mm_set1_ps(floorY);
+        const __m128 vZero  = _mm_setzero_ps();
+        const __m128i zi    = _mm_setzero_si128();
+
+        for (int i = 0; i < n4; i += 4) {
+            // 4 bytes de flaps → máscara de 32 bits por carril
+            int32_t raw;
+            std::memcpy(&raw, flaps + i, 4);
+            __m128i f = _mm_cvtsi32_si128(raw);
+            f = _mm_unpacklo_epi8(f, zi);
+            f = _mm_unpacklo_epi16(f, zi);
+            __m128 flapMask = _mm_castsi128_ps(_mm_cmpgt_epi32(f, zi));
+
+            __m128 live = _mm_loadu_ps(reinterpret_cast<const float*>(alive + i));
+            __m128 py   = _mm_loadu_ps(y + i);
+            __m128 pvy  = _mm_loadu_ps(vy + i);
+
+            __m128 nvy = _mm_add_ps(vFall, _mm_and_ps(flapMask, vJump));
+            __m128 ny  = _mm_add_ps(py, _mm_mul_ps(nvy, vDt));
+
+            // Solo se mueven los vivos
+            ny  = _mm_or_ps(_mm_and_ps(live, ny),  _mm_andnot_ps(live, py));
+            nvy = _mm_or_ps(_mm_and_ps(live, nvy), _mm_andnot_ps(live, pvy));
+
+            __m128 out = _mm_or_ps(_mm_cmplt_ps(ny, vZero),
+                                   _mm_cmpgt_ps(_mm_add_ps(ny, vH), vFloor));
+            live = _mm_andnot_ps(out, live);
+
+            _mm_storeu_ps(y + i, ny);
+            _mm_storeu_ps(vy + i, nvy);
+            _mm_storeu_ps(reinterpret_cast<float*>(alive + i), live);
+        }
+    }
+
+    void scoreSimd(int n4, const uint32_t* alive, int32_t* score, int32_t passed) {
+        const __m128i vPassed = _mm_set1_epi32(passed);
+        for (int i = 0; i < n4; i += 4) {
+            __m128i live = _mm_loadu_si128(reinterpret_cast<const __m128i*>(alive + i));
+            __m128i s    = _mm_loadu_si128(reinterpret_cast<const __m128i*>(score + i));
+            s = _mm_or_si128(_mm_and_si128(live, vPassed), _mm_andnot_si128(live, s));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(score + i), s);
+        }
+    }
+
+    void hitSimd(int n4, const float* y, uint32_t* alive,
+                 float h, const Band* bands, int nBands) {
+        const __m128 vH = _mm_set1_ps(h);
+        for (int i = 0; i < n4; i += 4) {
+            __m128 live = _mm_loadu_ps(reinterpret_cast<const float*>(alive + i));
+            __m128 py   = _mm_loadu_ps(y + i);
+            __m128 pyh  = _mm_add_ps(py, vH);
+            __m128 hit  = _mm_setzero_ps();
+            for (int b = 0; b < nBands; b++) {
+                __m128 in = _mm_and_ps(_mm_cmplt_ps(py, _mm_set1_ps(bands[b].bottom)),
+                                       _mm_cmpgt_ps(pyh, _mm_set1_ps(bands[b].top)));
+                hit = _mm_or_ps(hit, in);
+            }
+            _mm_storeu_ps(reinterpret_cast<float*>(alive + i), _mm_andnot_ps(hit, live));
+        }
+    }
+#endif
+}
+
+void Flock::reset(const WorldParams& params, uint32_t seed, int count) {
+    params_ = params;
+    field_.reset(params_, gapFor(params_), seed);
+
+    count_ = count > 0 ? count : 0;
+    aliveCount_ = count_;
+
+    const size_t padded = (size_t)((count_ + 3) & ~3);
+    const float startY = params_.screenH * params_.birdStartYFrac;
+    y_.assign(padded, startY);
+    vy_.assign(padded, 0.0f);
+    score_.assign(padded, 0);
+    alive_.assign(padded, 0u);
+    std::fill(alive_.begin(), alive_.begin() + count_, 0xFFFFFFFFu);
+}
+
+void Flock::step(float dt, const uint8_t* flaps) {
+    if (aliveCount_ == 0 || !(dt > 0.0f)) return;
+
+    const float h      = (float)params_.birdH;
+    const float floorY = params_.screenH - params_.groundH;
+    const float fall   = tickVelocity(params_, dt, false);
+    const float jump   = tickVelocity(params_, dt, true) - fall;
+
+    float* y = y_.data();
+    float* vy = vy_.data();
+    uint32_t* alive = alive_.data();
+    int32_t* score = score_.data();
+
+    const int n4 = FLOCK_SIMD ? (count_ & ~3) : 0;
+
+    // Física del pájaro (según enunciado) + salida de pantalla
+#if FLOCK_SIMD
+    integrateSimd(n4, flaps, y, vy, alive, jump, fall, dt, h, floorY);
+#endif
+    integrateScalar(n4, count_, flaps, y, vy, alive, jump, fall, dt, h, floorY);
+
+    // Tuberías compartidas; la puntuación cuenta para los que siguen vivos
+    field_.advance(dt, birdX());
+#if FLOCK_SIMD
+    scoreSimd(n4, alive, score, field_.passed());
+#endif
+    scoreScalar(n4, count_, alive, score, field_.passed());
+
+    // Broad phase: solo las parejas que solapan en x con los pájaros. Casi
+    // siempre es una; con tuberías muy juntas (sweep) pueden ser más, y se
+    // prueban de BAND_PAIRS en BAND_PAIRS, sin dejar ninguna fuera.
+    const int BAND_PAIRS = 4;
+    Band bands[2 * BAND_PAIRS];
+    const float bx = birdX();
+    const float bw = (float)params_.birdW;
+    const float ph = params_.pipeH;
+    int first, last;
+    field_.overlapping(bx, bx + bw, first, last);
+    for (int chunk = first; chunk < last; chunk += BAND_PAIRS) {
+        int nBands = 0;
+        for (int i = chunk; i < last && i < chunk + BAND_PAIRS; i++) {
+            const PipePair& p = field_[i];
+            bands[nBands++] = Band{ p.topY, p.topY + ph };
+            bands[nBands++] = Band{ p.botY, p.botY + ph };
+        }
+#if FLOCK_SIMD
+        hitSimd(n4, y, alive, h, bands, nBands);
+#endif
+        hitScalar(n4, count_, y, alive, h, bands, nBands);
+    }
+
+    int n = 0;
+    for (int i = 0; i < count_; i++) n += alive[i] != 0;
+    aliveCount_ = n;
+}
@@ -0,0 +1,45 @@
+#pragma once
+#include <vector>
+#include <cstdint>
+
+#include "World.hpp"
+
+// Modo multi-pájaro: N pájaros (1k–100k) comparten un mismo PipeField.
+// El estado de los pájaros va en SoA (un array por campo) y cada tick se
+// procesa con kernels SIMD (SSE2 si está disponible, escalar si no).
+// Todos los pájaros están en la misma x, así que el broad phase contra las
+// tuberías es escalar y solo el test en y se hace por pájaro.
+class Flock {
+public:
+    void reset(const WorldParams& params, uint32_t seed, int count);
+
+    // flaps[i] != 0 → el pájaro i salta este tick. Debe tener size() entradas.
+    // Con dt <= 0 (o NaN) no hace nada, como World::step.
+    void step(float dt, const uint8_t* flaps);
+
+    int size() const { return count_; }
+    int aliveCount() const { return aliveCount_; }
+    bool alive(int i) const { return alive_[i] != 0; }
+
+    // Arrays SoA (size() entradas válidas; el resto es relleno)
+    const float*   y() const { return y_.data(); }
+    const float*   vy() const { return vy_.data(); }
+    const int32_t* score() const { return score_.data(); }
+
+    float birdX() const { return params_.birdStartX; }
+    const WorldParams& params() const { return params_; }
+    const PipeField& field() const { return field_; }
+
+private:
+    WorldParams params_{};
+    PipeField field_;
+
+    int count_{0};
+    int aliveCount_{0};
+
+    // Relleno hasta múltiplo de 4 (carriles SSE); los de relleno nacen muertos
+    std::vector<float>    y_;
+    std::vector<float>    vy_;
+    std::vector<uint32_t> alive_;   // 0xFFFFFFFF vivo, 0 muerto (máscara por carril)
+    std::vector<int32_t>  score_;
+};
@@ -4,37 +4,70 @@ extern "C" {
 #include "GameOverState.hpp"
 #include "MainGameState.hpp"
 #include "StateMachine.hpp"
+#include "Viewport.hpp"
+#include "InputQueue.hpp"
+#include <cstdio>
 #include <memory>
-#include <string>
+
+namespace {
+    const char* const GAMEOVER_PATH = "assets/gameover.png";
+    // Piloto automático: cuánto se ve la pantalla antes de la siguiente partida
+    const float AUTO_RESTART_SECONDS = 1.5f;
+    int g_autoGames = 0;   // partidas jugadas por el piloto (para pruebas largas)
+}
 
 GameOverState::GameOverState(StateMachine* sm, int finalScore)
-: sm_(sm), score_(finalScore) {
-    texGameOver_ = LoadTexture("assets/gameover.png");
-    SetTextureFilter(texGameOver_, TEXTURE_FILTER_BILINEAR);
+: sm_(sm), score_(finalScore), autopilot_(sm->runConfig().autopilot != nullptr) {}
+
+void GameOverState::init() {
+    // Se llama al activarse: para entonces el StateMachine ya esperó a que
+    // la textura estuviera precargada en la caché
+    // Sin SetTextureFilter: va a escala 1:1 en el frame lógico y, con el
+    // pack, la textura es el atlas de todos
+    texGameOver_ = sm_->textures().acquire(GAMEOVER_PATH);
+
+    // La puntuación no cambia mientras dure el estado
+    std::snprintf(scoreText_, sizeof(scoreText_), "Score: %d", score_);
+    scoreWidth_ = MeasureText(scoreText_, 24);
+    markDirty();
+
+    if (autopilot_) TraceLog(LOG_INFO, "AUTOPILOT: partida %d, %d puntos", ++g_autoGames, score_);
+}
+
+void GameOverState::listAssets(std::vector<const char*>& out) const {
+    out.push_back(GAMEOVER_PATH);
 }
 
 GameOverState::~GameOverState() {
-    if (texGameOver_.id) UnloadTexture(texGameOver_);
+    // texGameOver_ es un handle de la caché: se queda residente para la próxima partida
 }
 
 void GameOverState::handleInput() {
-    if (IsKeyPressed(KEY_SPACE)) {
+    if (sm_->input().pressed(KEY_SPACE)) {
+        sm_->add_state(std::make_unique<MainGameState>(sm_), true);
+    }
+}
+
+void GameOverState::update(float dt) {
+    // Puede correr en el hilo de simulación, igual que el Game Over de
+    // MainGameState::update: el cambio de estado ya está preparado para eso
+    if (!autopilot_ || restarting_) return;
+    elapsed_ += dt;
+    if (elapsed_ >= AUTO_RESTART_SECONDS) {
+        restarting_ = true;   // hasta el cambio puede haber más pasos
         sm_->add_state(std::make_unique<MainGameState>(sm_), true);
     }
 }
 
-void GameOverState::render() {
-    BeginDrawing();
+void GameOverState::render(float) {
+    // El bucle principal ya tiene activo el Viewport: dibujamos en píxeles lógicos
     ClearBackground(RAYWHITE);
 
-    int x = GetScreenWidth()/2 - texGameOver_.width/2;
-    int y = GetScreenHeight()/2 - texGameOver_.height/2;
-    DrawTexture(texGameOver_, x, y, WHITE);
+    int x = LOGICAL_W/2 - texGameOver_->width/2;
+    int y = LOGICAL_H/2 - texGameOver_->height/2;
+    DrawTextureRec(texGameOver_->tex, texGameOver_->src, Vector2{(float)x, (float)y}, WHITE);
 
-    std::string s = "Score: " + std::to_string(score_);
-    int sw = MeasureText(s.c_str(), 24);
-    DrawText(s.c_str(), (GetScreenWidth()-sw)/2, GetScreenHeight()-50, 24, BLACK);
+    DrawText(scoreText_, (LOGICAL_W-scoreWidth_)/2, LOGICAL_H-50, 24, BLACK);
 
-    EndDrawing();
 }
 
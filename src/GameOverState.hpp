@@ -1,5 +1,6 @@
 #pragma once
 #include "GameState.hpp"
+#include "TextureCache.hpp"
 class StateMachine;
 extern "C" {
     #include <raylib.h>
@@ -10,17 +11,27 @@ public:
     GameOverState(StateMachine* sm, int finalScore);
     ~GameOverState(); 
 
-    void init() override {}
+    void init() override;
+    void listAssets(std::vector<const char*>& out) const override;
+    const char* name() const override { return "GameOverState"; }
     void pause() override {}
     void resume() override {}
 
     void handleInput() override;
-    void update(float) override {}
-    void render() override;
+    void update(float dt) override;
+    void render(float alpha) override;
+    // Pantalla fija: se dibuja al entrar. Con el piloto automático cuenta el
+    // tiempo hasta reiniciar sola, así que necesita sus pasos.
+    bool animating() const override { return autopilot_; }
 
 private:
     StateMachine* sm_{nullptr};
     int score_{0};
-    Texture2D texGameOver_{};
+    TextureRef texGameOver_{};
+    char scoreText_[32]{};   // "Score: N", formateado y medido una vez en init
+    int scoreWidth_{0};
+    bool autopilot_{false};
+    float elapsed_{0.0f};
+    bool restarting_{false};
 };
 
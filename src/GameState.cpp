@@ -1,3 +1,65 @@
 #include <GameState.hpp>
+#include <atomic>
+#include <new>
 
-GameState::GameState() : state_machine(nullptr){}
\ No newline at end of file
+namespace {
+    // Como mucho hay vivos el estado actual, el que lo sustituye y alguno
+    // apilado: 4 slots sobran
+    const int STATE_SLOTS = 4;
+    const std::size_t STATE_SLOT_SIZE = 16 * 1024;
+    // Los estados llevan miembros alignas(64) (TripleBuffer, SpscRing): los
+    // slots tienen que estar alineados a línea de caché, no a max_align_t
+    const std::size_t STATE_SLOT_ALIGN = 64;
+
+    alignas(STATE_SLOT_ALIGN) unsigned char g_slots[STATE_SLOTS][STATE_SLOT_SIZE];
+    std::atomic<bool> g_used[STATE_SLOTS];
+
+    void* takeSlot(std::size_t size, std::size_t align)
+    {
+        if (size > STATE_SLOT_SIZE || align > STATE_SLOT_ALIGN) return nullptr;
+        for (int i = 0; i < STATE_SLOTS; i++)
+        {
+            bool expected = false;
+            if (g_used[i].compare_exchange_strong(expected, true)) return g_slots[i];
+        }
+        return nullptr;
+    }
+
+    bool releaseSlot(void* p)
+    {
+        for (int i = 0; i < STATE_SLOTS; i++)
+        {
+            if (p == g_slots[i])
+            {
+                g_used[i].store(false);
+                return true;
+            }
+        }
+        return false;
+    }
+}
+
+GameState::GameState() : state_machine(nullptr){}
+
+void* GameState::operator new(std::size_t size)
+{
+    if (void* p = takeSlot(size, alignof(std::max_align_t))) return p;
+    return ::operator new(size);
+}
+
+// La que usa new para estados con alignof > __STDCPP_DEFAULT_NEW_ALIGNMENT__
+void* GameState::operator new(std::size_t size, std::align_val_t align)
+{
+    if (void* p = takeSlot(size, (std::size_t)align)) return p;
+    return ::operator new(size, align);
+}
+
+void GameState::operator delete(void* p) noexcept
+{
+    if (!releaseSlot(p)) ::operator delete(p);
+}
+
+void GameState::operator delete(void* p, std::align_val_t align) noexcept
+{
+    if (!releaseSlot(p)) ::operator delete(p, align);
+}
@@ -1,5 +1,8 @@
 #pragma once
 #include <memory>
+#include <vector>
+#include <cstddef>
+#include <new>
 
 class StateMachine;
 
@@ -12,14 +15,52 @@ class GameState
 
         virtual void init() = 0;
         virtual void handleInput() = 0;
-        virtual void update(float deltaTime) = 0;
-        virtual void render() = 0;
+        virtual void update(float deltaTime) = 0;   // un paso fijo de simulación
+        // alpha: fracción [0,1) del siguiente paso fijo ya transcurrida,
+        // para interpolar entre los dos últimos estados simulados
+        virtual void render(float alpha) = 0;
 
         virtual void pause() = 0;
         virtual void resume() = 0;
 
+        // Rutas de las texturas que init() va a pedir; el StateMachine las
+        // precarga y no activa el estado hasta tenerlas
+        virtual void listAssets(std::vector<const char*>& out) const {(void)out;}
+
+        // Estados estáticos (animating() == false): ni update() ni el paso
+        // del tiempo cambian lo que dibujan, solo la entrada, y lo avisan con
+        // markDirty(). main solo los vuelve a dibujar entonces y, mientras
+        // tanto, duerme esperando eventos en vez de repetir el mismo frame.
+        virtual bool animating() const {return true;}
+        void markDirty() {needs_redraw = true;}
+        bool takeDirty() {const bool d = needs_redraw; needs_redraw = false; return d;}
+
+        // Nombre para informes de depuración (allocs por estado, etc.)
+        virtual const char* name() const {return "GameState";}
+
+        // Instante (inputNow()) de la entrada más reciente que ya se ve en lo
+        // que dibujó el último render(); 0 si no hay. Para medir latencia.
+        virtual double presentedInputTime() const {return 0.0;}
+
+        // Instante real (inputNow()) en que empieza el paso que va a simular
+        // el próximo update(). Lo fija quien da los pasos (main o SimThread)
+        // y sirve para colocar cada evento de entrada en su paso.
+        void setStepStart(double t) {step_start = t;}
+        double stepStart() const {return step_start;}
+
+        // Los estados salen de un pool fijo de slots (GameState.cpp): cada
+        // reinicio hace make_unique y así no toca el heap. Si un estado no
+        // cabe o no quedan slots, se cae al operator new global. Las
+        // versiones con align_val_t son las de los estados sobrealineados.
+        static void* operator new(std::size_t size);
+        static void* operator new(std::size_t size, std::align_val_t align);
+        static void operator delete(void* p) noexcept;
+        static void operator delete(void* p, std::align_val_t align) noexcept;
+
         void setStateMachine(StateMachine* stt_mch) {state_machine = stt_mch;}
 
     protected:
         StateMachine* state_machine;
+        double step_start = 0.0;
+        bool needs_redraw = true;   // el primer frame siempre se dibuja
 };
\ No newline at end of file
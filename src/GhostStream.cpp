@@ -0,0 +1,361 @@
+#include "GhostStream.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#if !defined(_WIN32)
+    #include <cerrno>
+    #include <csignal>
+    #include <fcntl.h>
+    #include <unistd.h>
+#endif
+
+namespace {
+    const char MAGIC[4] = {'F', 'B', 'G', 'S'};
+    const size_t HEADER_BYTES = 20;
+
+    uint64_t zigzag(int64_t v) { return ((uint64_t)v << 1) ^ (uint64_t)(v >> 63); }
+    int64_t unzigzag(uint64_t v) { return (int64_t)(v >> 1) ^ -(int64_t)(v & 1); }
+
+    int32_t quantize(float v) { return (int32_t)std::lround(v * GhostEncoder::QUANT); }
+}
+
+// --- GhostEncoder
+
+GhostEncoder::GhostEncoder(const GhostHeader& header) : header_(header) {
+    if (header_.sampleEvery == 0) header_.sampleEvery = 1;
+
+    uint8_t b[HEADER_BYTES];
+    std::memcpy(b, MAGIC, 4);
+    b[4] = (uint8_t)header_.version;  b[5] = (uint8_t)(header_.version >> 8);
+    b[6] = (uint8_t)header_.sampleEvery; b[7] = (uint8_t)(header_.sampleEvery >> 8);
+    for (int i = 0; i < 4; i++) b[8 + i] = (uint8_t)(header_.seed >> (8 * i));
+    uint64_t hz;
+    std::memcpy(&hz, &header_.simHz, 8);
+    for (int i = 0; i < 8; i++) b[12 + i] = (uint8_t)(hz >> (8 * i));
+    buffer_.assign(b, b + HEADER_BYTES);
+}
+
+void GhostEncoder::putVarint(uint64_t v) {
+    while (v >= 0x80) {
+        buffer_.push_back((uint8_t)(v | 0x80));
+        v >>= 7;
+    }
+    buffer_.push_back((uint8_t)v);
+}
+
+void GhostEncoder::step(uint32_t tick, float birdY, float birdVy, int score, uint32_t spawned,
+                        bool dead, bool flap) {
+    if (ended_) return;
+
+    if (score != score_) {
+        score_ = score;
+        put(GhostMsg::Score, (uint64_t)score_);
+    }
+    if (spawned != spawned_) {
+        spawned_ = spawned;
+        put(GhostMsg::Spawn, spawned_);
+    }
+    if (flap && samples_ > 0) {
+        put(GhostMsg::Flap, tick - lastTick_);
+        flapped_ = true;
+    }
+
+    // La muerte cierra con una clave en su tick: la última y es exacta
+    if (!dead && tick % header_.sampleEvery != 0) return;
+
+    const int32_t y = quantize(birdY);
+    if (samples_ == 0) {
+        // Sin muestra anterior, la velocidad libre sale de vy (si este paso
+        // no saltó; si saltó, la primera ventana sin saltos la corrige)
+        freeStep_ = flap ? 0 : quantize((float)(birdVy * header_.sampleEvery / header_.simHz));
+    }
+    // Solo una ventana entera y sin saltos dice cuánto se cae en un periodo.
+    // La muestra se predice con el valor anterior; la clave lleva el nuevo
+    const int32_t predicted = lastY_ + freeStep_;
+    if (samples_ > 0 && !flapped_ && tick - lastTick_ == header_.sampleEvery) freeStep_ = y - lastY_;
+    if (dead || samples_ % KEY_EVERY == 0) {
+        put(GhostMsg::Key, 0);
+        putVarint(tick);
+        putVarint(zigzag(y));
+        putVarint(zigzag(freeStep_));
+        putVarint((uint64_t)score_);
+    } else {
+        put(GhostMsg::Sample, zigzag((int64_t)y - predicted));
+    }
+    lastY_ = y;
+    lastTick_ = tick;
+    flapped_ = false;
+    samples_++;
+
+    if (dead) {
+        put(GhostMsg::End, 0);
+        ended_ = true;
+    }
+}
+
+// --- GhostDecoder
+
+size_t GhostDecoder::feed(const uint8_t* data, size_t n) {
+    // Lo ya consumido se descarta solo cuando hace falta sitio: lo que queda
+    // por consumir son unos pocos bytes
+    if (end_ + n > CAPACITY && pos_ > 0) {
+        std::memmove(bytes_, bytes_ + pos_, end_ - pos_);
+        end_ -= pos_;
+        pos_ = 0;
+    }
+    n = std::min(n, CAPACITY - end_);
+    std::memcpy(bytes_ + end_, data, n);
+    end_ += n;
+    return n;
+}
+
+bool GhostDecoder::parseHeader() {
+    if (end_ - pos_ < HEADER_BYTES) return false;
+    const uint8_t* b = bytes_ + pos_;
+    if (std::memcmp(b, MAGIC, 4) != 0) {
+        broken_ = true;
+        return false;
+    }
+    header_.version     = (uint16_t)(b[4] | (b[5] << 8));
+    header_.sampleEvery = (uint16_t)(b[6] | (b[7] << 8));
+    header_.seed = 0;
+    for (int i = 0; i < 4; i++) header_.seed |= (uint32_t)b[8 + i] << (8 * i);
+    uint64_t hz = 0;
+    for (int i = 0; i < 8; i++) hz |= (uint64_t)b[12 + i] << (8 * i);
+    std::memcpy(&header_.simHz, &hz, 8);
+    if (header_.version != GhostHeader{}.version || header_.sampleEvery == 0 || header_.simHz <= 0.0) {
+        broken_ = true;
+        return false;
+    }
+    pos_ += HEADER_BYTES;
+    hasHeader_ = true;
+    return true;
+}
+
+bool GhostDecoder::getVarint(size_t& pos, uint64_t& v) const {
+    v = 0;
+    for (int shift = 0; shift < 64; shift += 7) {
+        if (pos >= end_) return false;
+        const uint8_t b = bytes_[pos++];
+        v |= (uint64_t)(b & 0x7F) << shift;
+        if (!(b & 0x80)) return true;
+    }
+    return false;
+}
+
+void GhostDecoder::push(Sample s) {
+    prev_ = next_;
+    hasPrev_ = hasNext_;
+    next_ = s;
+    hasNext_ = true;
+    std::memcpy(flapTicks_, pendingTicks_, sizeof(flapTicks_));
+    flaps_ = pending_;
+    pending_ = 0;
+}
+
+int32_t GhostDecoder::jumpsUpTo(const uint32_t* ticks, int n, double t) const {
+    int k = 0;
+    while (k < n && ticks[k] <= t) k++;
+    return jump_ * k;
+}
+
+bool GhostDecoder::parseMessage() {
+    size_t pos = pos_;
+    uint64_t tag;
+    if (!getVarint(pos, tag)) return false;
+    const uint64_t value = tag >> 3;
+
+    switch ((GhostMsg)(tag & 7)) {
+        case GhostMsg::Sample: {
+            // Sin clave previa (se entró a mitad) no hay de dónde predecir
+            if (hasNext_) {
+                const int32_t residual = (int32_t)unzigzag(value);
+                const int32_t y = next_.y + freeStep_ + residual;
+                if (pending_ == 1) jump_ = residual;   // un salto solo: su escalón, limpio
+                // La ventana va de la última muestra al siguiente múltiplo
+                // (tras una clave de muerte no hay más muestras)
+                const uint32_t tick = next_.tick - next_.tick % header_.sampleEvery + header_.sampleEvery;
+                const bool full = tick - next_.tick == header_.sampleEvery;
+                const int32_t last = next_.y;
+                const bool flapped = pending_ > 0;
+                push(Sample{tick, y});
+                if (!flapped && full) freeStep_ = y - last;
+            }
+            break;
+        }
+        case GhostMsg::Key: {
+            uint64_t tick, y, vy, score;
+            if (!getVarint(pos, tick) || !getVarint(pos, y) ||
+                !getVarint(pos, vy) || !getVarint(pos, score)) return false;
+            push(Sample{(uint32_t)tick, (int32_t)unzigzag(y)});
+            freeStep_ = (int32_t)unzigzag(vy);
+            score_ = (int)score;
+            break;
+        }
+        case GhostMsg::Flap:
+            // Entrando a mitad, los saltos anteriores a la primera clave no sirven
+            if (hasNext_ && pending_ < MAX_FLAPS) pendingTicks_[pending_++] = next_.tick + (uint32_t)value;
+            break;
+        case GhostMsg::Score: score_ = (int)value;        break;
+        case GhostMsg::Spawn: spawned_ = (uint32_t)value; break;
+        case GhostMsg::End:   ended_ = true;              break;
+        default:
+            broken_ = true;
+            return false;
+    }
+    pos_ = pos;
+    return true;
+}
+
+bool GhostDecoder::advanceTo(uint32_t tick) {
+    if (broken_) return false;
+    if (!hasHeader_ && !parseHeader()) return false;
+    while (needsData(tick) && parseMessage()) {}
+    // El fin va justo detrás de la clave de la muerte: que se sepa ya, sin
+    // esperar a que pidan un tick posterior
+    size_t pos = pos_;
+    uint64_t tag;
+    if (!ended_ && getVarint(pos, tag) && (GhostMsg)(tag & 7) == GhostMsg::End) {
+        ended_ = true;
+        pos_ = pos;
+    }
+    return hasNext_ && next_.tick >= tick;
+}
+
+bool GhostDecoder::positionAt(uint32_t tick, float frac, float& y) const {
+    const double t = (double)tick + frac;
+    if (!hasNext_) return false;
+
+    // Con la física de World: caída a velocidad constante (freeStep_ por
+    // periodo) y un escalón por salto, en el tick en que se dio
+    const float q = 1.0f / GhostEncoder::QUANT;
+    const double perTick = (double)freeStep_ / header_.sampleEvery;
+
+    // En vivo la siguiente muestra aún no ha llegado: se extrapola durante
+    // como mucho un periodo de muestreo, con los saltos que ya se conocen
+    if (t > next_.tick) {
+        if (ended_ || t > (double)next_.tick + header_.sampleEvery) return false;
+        y = (float)(next_.y + jumpsUpTo(pendingTicks_, pending_, t) + perTick * (t - next_.tick)) * q;
+        return true;
+    }
+    if (hasPrev_ && t >= prev_.tick && next_.tick > prev_.tick) {
+        if (flaps_ == 0) {   // sin saltos, la recta entre las dos muestras
+            const double a = (t - prev_.tick) / (double)(next_.tick - prev_.tick);
+            y = (float)(prev_.y + (next_.y - prev_.y) * a) * q;
+        } else if (t < flapTicks_[0]) {
+            y = (float)(prev_.y + perTick * (t - prev_.tick)) * q;
+        } else {   // desde el primer salto, hacia atrás desde next_ (así casa con ella)
+            const int32_t after = jumpsUpTo(flapTicks_, flaps_, (double)next_.tick) -
+                                  jumpsUpTo(flapTicks_, flaps_, t);
+            y = (float)(next_.y - after - perTick * (next_.tick - t)) * q;
+        }
+        return true;
+    }
+    if (t == next_.tick) {   // la primera muestra, sin anterior
+        y = next_.y * q;
+        return true;
+    }
+    return false;   // anterior a lo que queda decodificado
+}
+
+// --- Transporte
+
+#if !defined(_WIN32)
+
+GhostPublisher::~GhostPublisher() {
+    if (fd_ >= 0) flush();
+    if (fd_ >= 0) ::close(fd_);
+}
+
+bool GhostPublisher::open(const char* path) {
+    // Un lector que se va no debe matar el juego con SIGPIPE: write() falla
+    // con EPIPE y se deja de publicar
+    std::signal(SIGPIPE, SIG_IGN);
+
+    // Con un FIFO sin lector esto falla (ENXIO): abrir antes el espectador
+    fd_ = ::open(path, O_WRONLY | O_CREAT | O_TRUNC | O_NONBLOCK, 0644);
+    if (fd_ < 0) return false;
+    pending_.reserve(MAX_PENDING);
+    pending_ = encoder_.buffer();   // la cabecera
+    encoder_.consumed();
+    flush();
+    return true;
+}
+
+void GhostPublisher::step(uint32_t tick, const World& world, bool flap) {
+    if (fd_ < 0) return;
+    encoder_.step(tick, world, flap);
+    const std::vector<uint8_t>& out = encoder_.buffer();
+    if (out.empty()) return;
+
+    if (pending_.size() + out.size() > MAX_PENDING) {   // el lector no da abasto: se corta
+        ::close(fd_);
+        fd_ = -1;
+        return;
+    }
+    pending_.insert(pending_.end(), out.begin(), out.end());
+    encoder_.consumed();
+    flush();
+}
+
+void GhostPublisher::flush() {
+    size_t done = 0;
+    while (done < pending_.size()) {
+        const ssize_t n = ::write(fd_, pending_.data() + done, pending_.size() - done);
+        if (n > 0) {
+            done += (size_t)n;
+            written_ += (size_t)n;
+        } else if (n < 0 && errno == EINTR) {
+            continue;
+        } else {
+            if (n < 0 && errno != EAGAIN && errno != EWOULDBLOCK) {
+                ::close(fd_);
+                fd_ = -1;
+            }
+            break;
+        }
+    }
+    pending_.erase(pending_.begin(), pending_.begin() + (std::ptrdiff_t)done);
+}
+
+GhostSource::~GhostSource() {
+    if (fd_ >= 0) ::close(fd_);
+}
+
+bool GhostSource::open(const char* path) {
+    fd_ = ::open(path, O_RDONLY | O_NONBLOCK);
+    return fd_ >= 0;
+}
+
+void GhostSource::poll(GhostDecoder& decoder) {
+    if (fd_ < 0) return;
+    // Sin leer más de lo que le cabe al decoder: el resto espera en el
+    // fichero (o en el FIFO) a que lo vaya consumiendo
+    uint8_t chunk[4096];
+    for (;;) {
+        const size_t want = std::min(sizeof(chunk), decoder.space());
+        if (want == 0) break;
+        const ssize_t n = ::read(fd_, chunk, want);
+        if (n > 0) {
+            decoder.feed(chunk, (size_t)n);
+        } else if (n < 0 && errno == EINTR) {
+            continue;
+        } else {
+            break;   // 0: de momento no hay más (fichero que crece o FIFO); EAGAIN igual
+        }
+    }
+}
+
+#else
+
+// Sin transporte en Windows: el flujo se puede seguir usando en memoria
+GhostPublisher::~GhostPublisher() {}
+bool GhostPublisher::open(const char*) { return false; }
+void GhostPublisher::step(uint32_t, const World&, bool) {}
+void GhostPublisher::flush() {}
+GhostSource::~GhostSource() {}
+bool GhostSource::open(const char*) { return false; }
+void GhostSource::poll(GhostDecoder&) {}
+
+#endif
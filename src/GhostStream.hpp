@@ -0,0 +1,181 @@
+#pragma once
+#include "World.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Flujo en vivo de una partida para fantasmas y espectadores. No lleva las
+// tuberías: salen de la semilla (PipeField es determinista), así que basta
+// con el pájaro, muestreado a ~15 Hz y cuantizado a 1/4 de píxel, y los
+// saltos (con la física de World la caída es a velocidad constante y cada
+// salto es un escalón en un solo tick: sabiendo en qué tick fue, la y entre
+// muestras sale exacta).
+//
+// Formato (.fbg, little-endian):
+//   cabecera  "FBGS", u16 versión, u16 sampleEvery (ticks), u32 semilla, f64 simHz
+//   mensajes  varint(dato << 3 | tipo)
+//     0 muestra  dato = zigzag(y - predicción): predicción = y anterior +
+//                velocidad libre (desplazamiento por muestra sin saltos);
+//                1 byte en caída libre, 2 si hubo salto
+//     1 clave    dato = 0; siguen varint tick, zigzag y, zigzag velocidad
+//                libre, varint puntuación. Reinicia la predicción (se puede
+//                entrar a mitad)
+//     2 puntos   dato = puntuación nueva
+//     3 tubería  dato = tuberías nacidas hasta ahora (World::pipes().spawned())
+//     4 fin      dato = 0
+//     5 salto    dato = ticks desde la última muestra (va antes de la muestra
+//                que lo incluye)
+// Las muestras van cada sampleEvery ticks; cada KEY_EVERY muestras, una
+// clave en su lugar. En total, unas decenas de bytes por segundo.
+struct GhostHeader {
+    uint16_t version{1};
+    uint16_t sampleEvery{16};   // 240 Hz / 16 = 15 muestras por segundo
+    uint32_t seed{0};
+    double   simHz{240.0};
+};
+
+enum class GhostMsg : uint8_t { Sample = 0, Key = 1, Score = 2, Spawn = 3, End = 4, Flap = 5 };
+
+// Lado del juego: convierte los pasos del World en mensajes. Los bytes se
+// acumulan en buffer() y los saca GhostPublisher (o quien sea: en los tests
+// de loopback, directamente un GhostDecoder).
+class GhostEncoder {
+public:
+    static constexpr int QUANT = 4;        // subpíxeles por píxel
+    static constexpr int KEY_EVERY = 15;   // una clave por segundo a 15 Hz
+
+    explicit GhostEncoder(const GhostHeader& header);
+
+    // Tras cada World::step (tick = índice del paso, desde 0; flap = si ese
+    // paso saltó)
+    void step(uint32_t tick, const World& world, bool flap) {
+        step(tick, world.bird().y, world.bird().vy, world.score(), world.pipes().spawned(), world.dead(), flap);
+    }
+    // Lo mismo con los valores sueltos (un pájaro de un Flock, por ejemplo)
+    void step(uint32_t tick, float y, float vy, int score, uint32_t spawned, bool dead, bool flap);
+
+    const std::vector<uint8_t>& buffer() const { return buffer_; }
+    void consumed() { buffer_.clear(); }
+
+private:
+    void putVarint(uint64_t v);
+    void put(GhostMsg kind, uint64_t value) { putVarint((value << 3) | (uint64_t)kind); }
+
+    GhostHeader header_;
+    std::vector<uint8_t> buffer_;
+    int32_t lastY_{0};
+    uint32_t lastTick_{0};
+    int32_t freeStep_{0};     // desplazamiento por muestra sin saltos (1/QUANT px)
+    bool flapped_{false};     // hubo salto desde la última muestra
+    uint32_t samples_{0};
+    int score_{0};
+    uint32_t spawned_{0};
+    bool ended_{false};
+};
+
+// Lado del espectador: reconstruye la y del pájaro en cualquier tick ya
+// recibido. Decodifica a demanda (advanceTo): el coste es el de los bytes que
+// se consumen, unos pocos por muestra, así que cientos de fantasmas no se
+// notan.
+//
+// Los bytes van en un buffer de tamaño fijo dentro del propio decoder: se
+// alimenta desde render (MainGameState::drawGhosts) y ahí no se reserva.
+// Lo que no cabe se queda en el transporte hasta que se consuma.
+class GhostDecoder {
+public:
+    static constexpr size_t CAPACITY = 16 * 1024;
+
+    // Bytes recién llegados; devuelve cuántos cupieron (los demás, otra vez)
+    size_t feed(const uint8_t* data, size_t n);
+    size_t space() const { return CAPACITY - (end_ - pos_); }   // lo que cabe ahora
+
+    bool hasHeader() const { return hasHeader_; }
+    const GhostHeader& header() const { return header_; }
+    bool broken() const { return broken_; }     // cabecera o mensaje inválido
+
+    // Consume mensajes hasta tener una muestra en o después de tick (o hasta
+    // que falten bytes). Devuelve true si la tiene.
+    bool advanceTo(uint32_t tick);
+
+    // y en el instante tick + frac (frac en [0,1)), interpolada entre las dos
+    // muestras que lo rodean o, pasada la última, extrapolada hasta un periodo
+    // de muestreo; false si no se sabe o la partida ya había acabado
+    bool positionAt(uint32_t tick, float frac, float& y) const;
+
+    int score() const { return score_; }
+    uint32_t spawned() const { return spawned_; }
+    bool ended() const { return ended_; }
+    bool needsData(uint32_t tick) const { return !ended_ && (!hasNext_ || next_.tick < tick); }
+
+private:
+    struct Sample { uint32_t tick; int32_t y; };
+
+    bool parseHeader();
+    bool parseMessage();   // false si falta algún byte (no consume nada)
+    bool getVarint(size_t& pos, uint64_t& v) const;
+    void push(Sample s);   // next_ pasa a prev_; los saltos pendientes, a su intervalo
+    int32_t jumpsUpTo(const uint32_t* ticks, int n, double t) const;   // escalones hasta t
+
+    uint8_t bytes_[CAPACITY];
+    size_t pos_{0};   // siguiente byte sin consumir
+    size_t end_{0};   // fin de lo recibido
+    GhostHeader header_{};
+    bool hasHeader_{false};
+    bool broken_{false};
+
+    Sample prev_{0, 0};
+    Sample next_{0, 0};
+    bool hasPrev_{false};
+    bool hasNext_{false};
+    // Saltos por intervalo: más de MAX_FLAPS en un periodo no se da jugando
+    // (los que sobren solo se notan entre las dos muestras)
+    static constexpr int MAX_FLAPS = 4;
+    int32_t freeStep_{0};              // velocidad libre, como en el encoder
+    int32_t jump_{0};                  // escalón de un salto (se aprende de las muestras)
+    uint32_t flapTicks_[MAX_FLAPS]{};  // saltos en (prev_, next_]
+    int flaps_{0};
+    uint32_t pendingTicks_[MAX_FLAPS]{}; // saltos después de next_ (en vivo)
+    int pending_{0};
+    int score_{0};
+    uint32_t spawned_{0};
+    bool ended_{false};
+};
+
+// Transporte local: un fichero o un FIFO (mkfifo). El publicador escribe sin
+// bloquear: si el lector no está o va lento, los bytes esperan en memoria
+// (con tope) en vez de frenar la simulación.
+class GhostPublisher {
+public:
+    static constexpr size_t MAX_PENDING = 64 * 1024;
+
+    explicit GhostPublisher(const GhostHeader& header) : encoder_(header) {}
+    ~GhostPublisher();
+
+    GhostPublisher(const GhostPublisher&) = delete;
+    GhostPublisher& operator=(const GhostPublisher&) = delete;
+
+    bool open(const char* path);
+    void step(uint32_t tick, const World& world, bool flap);   // encode + write si hay bytes
+
+    size_t bytesWritten() const { return written_; }
+
+private:
+    void flush();
+
+    GhostEncoder encoder_;
+    std::vector<uint8_t> pending_;
+    int fd_{-1};
+    size_t written_{0};
+};
+
+// Lector sin bloqueo de un flujo (fichero que crece o FIFO)
+class GhostSource {
+public:
+    ~GhostSource();
+
+    bool open(const char* path);
+    void poll(GhostDecoder& decoder);   // pasa al decoder lo que haya llegado
+
+private:
+    int fd_{-1};
+};
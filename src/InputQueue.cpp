@@ -0,0 +1,61 @@
+extern "C" {
+    #include <raylib.h>
+}
+#include "InputQueue.hpp"
+#include <algorithm>
+#include <thread>
+
+void InputQueue::collect() {
+    const double now = inputNow();
+    for (int key = GetKeyPressed(); key != 0; key = GetKeyPressed()) {
+        if (count_ < CAPACITY) events_[count_++] = KeyEvent{ key, now };
+    }
+}
+
+void InputQueue::waitUntil(double deadline, double pollEvery) {
+    for (;;) {
+        const double remaining = deadline - inputNow();
+        if (remaining <= 0.0) return;
+        WaitTime(std::min(remaining, pollEvery));
+        PollInputEvents();
+        collect();
+    }
+}
+
+void InputQueue::sleepUntil(double deadline) {
+    const double remaining = deadline - inputNow();
+    if (remaining > 0.0) std::this_thread::sleep_for(std::chrono::duration<double>(remaining));
+    PollInputEvents();
+    collect();
+}
+
+void InputQueue::waitForEvents() {
+    // Solo durante esta llamada: con la espera activa también bloquearía
+    // el PollInputEvents de EndDrawing
+    EnableEventWaiting();
+    PollInputEvents();
+    DisableEventWaiting();
+    collect();
+}
+
+bool InputQueue::pressed(int key) const {
+    for (int i = 0; i < count_; i++) if (events_[i].key == key) return true;
+    return false;
+}
+
+void LatencyLog::add(double seconds) {
+    if (count_ < CAPACITY) samples_[count_++] = seconds;
+}
+
+LatencyLog::Stats LatencyLog::stats() const {
+    Stats s{0.0, 0.0, 0.0};
+    if (count_ == 0) return s;
+
+    static double sorted[CAPACITY];   // solo al salir
+    std::copy(samples_, samples_ + count_, sorted);
+    std::sort(sorted, sorted + count_);
+    s.p50 = sorted[count_ / 2] * 1e3;
+    s.p99 = sorted[std::min(count_ - 1, (count_ * 99) / 100)] * 1e3;
+    s.max = sorted[count_ - 1] * 1e3;
+    return s;
+}
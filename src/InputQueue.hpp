@@ -0,0 +1,67 @@
+#pragma once
+#include <chrono>
+
+// Reloj común de la entrada y de la simulación (segundos, monótono). Es el
+// mismo steady_clock que usa SimThread, así que los instantes de teclas y
+// de pasos se pueden comparar directamente.
+inline double inputNow() {
+    return std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+struct KeyEvent {
+    int    key;    // KeyboardKey de raylib
+    double time;   // inputNow() del sondeo en que apareció
+};
+
+// Teclas pulsadas durante el frame, en orden y con su instante. raylib solo
+// sabe "pulsada desde el último PollInputEvents", así que la precisión es la
+// del sondeo: en vez de dormir el resto del frame dentro de EndDrawing, main
+// espera con waitUntil(), que sondea cada ~1 ms.
+//
+// Los estados leen de aquí y no de IsKeyPressed (que solo ve el último
+// sondeo y perdería las pulsaciones de los anteriores).
+class InputQueue {
+public:
+    static constexpr int CAPACITY = 128;
+
+    // Vacía la cola de teclas de raylib (llamar tras cada PollInputEvents,
+    // también el que hace EndDrawing)
+    void collect();
+
+    // Espera hasta deadline (inputNow()) sondeando la entrada cada pollEvery s
+    void waitUntil(double deadline, double pollEvery = 0.001);
+
+    // Duerme hasta deadline de una vez y sondea al final: sin foco no llegan
+    // teclas, y así no hay despertares cada ms ni la espera activa de WaitTime
+    void sleepUntil(double deadline);
+
+    // Bloquea sin sondear hasta el siguiente evento de ventana o entrada
+    // (tecla, ratón, foco, tamaño, cerrar). Para cuando no hay nada que dibujar.
+    void waitForEvents();
+
+    int count() const { return count_; }
+    const KeyEvent& operator[](int i) const { return events_[i]; }
+    bool pressed(int key) const;
+
+    void clear() { count_ = 0; }   // tras handleInput
+
+private:
+    KeyEvent events_[CAPACITY];
+    int count_{0};
+};
+
+// Latencias tecla → frame visible (modo --input-latency)
+class LatencyLog {
+public:
+    static constexpr int CAPACITY = 4096;
+
+    void add(double seconds);
+    int count() const { return count_; }
+
+    struct Stats { double p50; double p99; double max; };
+    Stats stats() const;   // en milisegundos; ordena una copia
+
+private:
+    double samples_[CAPACITY];
+    int count_{0};
+};
@@ -4,210 +4,380 @@ extern "C" {
 #include "MainGameState.hpp"
 #include "StateMachine.hpp"
 #include "GameOverState.hpp"
+#include "SpriteBatch.hpp"
+#include "Viewport.hpp"
+#include "InputQueue.hpp"
 #include <memory>
 #include <string>
+#include <random>
+
+namespace {
+    // Todas las texturas de la partida (listAssets las precarga, init las pide)
+    const char* const BG_PATHS[2] = {
+        "assets/background-day.png", "assets/background-night.png"
+    };
+    const char* const GROUND_PATH = "assets/base.png";
+    const char* const DIGIT_PATHS[10] = {
+        "assets/0.png", "assets/1.png", "assets/2.png", "assets/3.png", "assets/4.png",
+        "assets/5.png", "assets/6.png", "assets/7.png", "assets/8.png", "assets/9.png"
+    };
+    // [color][frame] => 0:red,1:blue,2:yellow × 0:down,1:mid,2:up
+    const char* const BIRD_PATHS[3][3] = {
+        {"assets/redbird-downflap.png",    "assets/redbird-midflap.png",    "assets/redbird-upflap.png"},
+        {"assets/bluebird-downflap.png",   "assets/bluebird-midflap.png",   "assets/bluebird-upflap.png"},
+        {"assets/yellowbird-downflap.png", "assets/yellowbird-midflap.png", "assets/yellowbird-upflap.png"},
+    };
+    const char* const PIPE_GREEN_PATH = "assets/pipe-green.png";
+    const char* const PIPE_RED_PATH   = "assets/pipe-red.png";
+
+    // Lo que necesitará el siguiente estado: se decodifica mientras se juega
+    const char* const GAMEOVER_PATH = "assets/gameover.png";
+}
 
 MainGameState::MainGameState(StateMachine* sm) : sm_(sm) {}
 
 MainGameState::~MainGameState() {
-    // Libera TODO lo cargado
-    for (auto& t : texBg_) if (t.id) UnloadTexture(t);
-    if (texGround_.id) UnloadTexture(texGround_);
-    for (int c=0;c<3;c++) for (int f=0;f<3;f++) if (birdFrames_[c][f].id) UnloadTexture(birdFrames_[c][f]);
-    for (auto& t : texDigits_) if (t.id) UnloadTexture(t);
-    if (pipeGreen_.id) UnloadTexture(pipeGreen_);
-    if (pipeRed_.id)   UnloadTexture(pipeRed_);
-    if (birdSprite.id) UnloadTexture(birdSprite);   // por si quedó copiado
-    if (pipeSprite.id) UnloadTexture(pipeSprite);   // idem
+    // Las texturas son handles de la caché: se liberan solas y la caché
+    // decide cuándo descargarlas.
 }
 
 void MainGameState::init() {
-    SetRandomSeed(GetTime());
+    TextureCache& cache = sm_->textures();
+
+    // Semilla de la partida: de ella sale todo lo aleatorio (tuberías y
+    // aspecto), sin estado global. Reproduciendo, es la grabada.
+    const RunConfig& run = sm_->runConfig();
+    uint32_t seed = std::random_device{}();
+    if (run.replayPath) {
+        replay_ = std::make_unique<ReplayReader>();
+        if (replay_->open(run.replayPath)) {
+            seed = replay_->header().seed;
+            cursor_ = std::make_unique<ReplayCursor>(*replay_);
+        } else {
+            TraceLog(LOG_WARNING, "REPLAY: no se pudo leer %s; se juega normal", run.replayPath);
+            replay_.reset();
+        }
+    }
+
+    // Fantasmas: para correr contra ellos hacen falta sus mismas tuberías, así
+    // que sin repetición la semilla es la del primero (si su cabecera ya está)
+    for (const char* path : run.ghostPaths) {
+        auto g = std::make_unique<Ghost>();
+        if (!g->source.open(path)) {
+            TraceLog(LOG_WARNING, "GHOST: no se pudo abrir %s", path);
+            continue;
+        }
+        g->source.poll(g->decoder);
+        g->decoder.advanceTo(0);
+        if (g->decoder.broken()) {
+            TraceLog(LOG_WARNING, "GHOST: %s no es un flujo de fantasma", path);
+            continue;
+        }
+        if (g->decoder.hasHeader()) {
+            if (ghosts_.empty() && !replay_) seed = g->decoder.header().seed;
+            else if (g->decoder.header().seed != seed)
+                TraceLog(LOG_WARNING, "GHOST: %s es de otra semilla; sus tuberías no son estas", path);
+        }
+        ghosts_.push_back(std::move(g));
+    }
 
     // --- Fondos y suelo (usar day/night y base.png)
-    texBg_[0]    = LoadTexture("assets/background-day.png");
-    texBg_[1]    = LoadTexture("assets/background-night.png");
-    bgIdx_       = GetRandomValue(0,1);
-    texGround_   = LoadTexture("assets/base.png");
+    texBg_[0]    = cache.acquire(BG_PATHS[0]);
+    texBg_[1]    = cache.acquire(BG_PATHS[1]);
+    bgIdx_       = counterInt(seed, RngStream::Cosmetic, 0, 0, 1);
+    texGround_   = cache.acquire(GROUND_PATH);
 
     // --- Dígitos 0..9
     for (int i=0;i<10;i++) {
-        texDigits_[i] = LoadTexture(std::string("assets/" + std::to_string(i) + ".png").c_str());
+        texDigits_[i] = cache.acquire(DIGIT_PATHS[i]);
     }
 
     // --- Pájaros: 3 colores × 3 frames
-    const char* colors[3] = {"red","blue","yellow"};
-    const char* flaps[3]  = {"downflap","midflap","upflap"};
     for (int c=0;c<3;c++) {
         for (int f=0;f<3;f++) {
-            std::string path = std::string("assets/") + colors[c] + "bird-" + flaps[f] + ".png";
-            birdFrames_[c][f] = LoadTexture(path.c_str());
+            birdFrames_[c][f] = cache.acquire(BIRD_PATHS[c][f]);
         }
     }
-    birdColor_ = GetRandomValue(0,2);
-    birdFrame_ = 1; // mid
-    birdAnimTimer_ = 0.0f;
+    birdColor_ = counterInt(seed, RngStream::Cosmetic, 1, 0, 2);
+    for (size_t i = 0; i < ghosts_.size(); i++) ghosts_[i]->color = (birdColor_ + 1 + (int)i) % 3;
 
     // La práctica pide birdSprite: usamos el frame actual para cumplir requisito
-    birdSprite = birdFrames_[birdColor_][birdFrame_];
-
-    // Fijar tamaño del jugador por sprite
-    bird_.width  = birdSprite.width;
-    bird_.height = birdSprite.height;
-
-    // Posición inicial un poco hacia la derecha y centrada vertical
-    bird_.x = 128.0f;
-    bird_.y = GetScreenHeight()*0.42f;
+    birdSprite = birdFrames_[birdColor_][1];   // mid, el primero que anima World
 
     // --- Tuberías: dos colores y parámetros dimensiones
-    pipeGreen_ = LoadTexture("assets/pipe-green.png");
-    pipeRed_   = LoadTexture("assets/pipe-red.png");
+    pipeGreen_ = cache.acquire(PIPE_GREEN_PATH);
+    pipeRed_   = cache.acquire(PIPE_RED_PATH);
 
     // La práctica pide pipeSprite (variable del estado). Le damos uno por defecto.
     pipeSprite = pipeGreen_;
 
-    PIPE_W = (float)pipeGreen_.width;   // ambos pipes suelen tener mismo tamaño
-    PIPE_H = (float)pipeGreen_.height;
+    // --- Máscaras de colisión: las de las texturas (la caché las guarda con
+    // ellas); las de arriba se dibujan giradas 180°, así que se giran aquí
+    CollisionMasks masks;
+    for (int f=0;f<3;f++) masks.bird[f] = &birdFrames_[birdColor_][f].mask();
+    masks.pipe[0] = &pipeGreen_.mask();
+    masks.pipe[1] = &pipeRed_.mask();
+    for (int c=0;c<2;c++) {
+        pipeTopMask_[c] = masks.pipe[c]->rotated180();
+        masks.pipeTop[c] = &pipeTopMask_[c];
+    }
 
-    GAP = bird_.height * 4.5f;
+    // --- Mundo: dimensiones de pantalla, suelo y sprites como datos planos
+    WorldParams params;
+    params.screenW = (float)LOGICAL_W;    // píxeles lógicos, no los de la ventana
+    params.screenH = (float)LOGICAL_H;
+    params.groundH = texGround_->valid() ? (float)texGround_->height : 0.0f;
+    params.birdW   = birdSprite.width;          // tamaño del jugador por sprite
+    params.birdH   = birdSprite.height;
+    params.pipeW   = (float)pipeGreen_->width;   // ambos pipes suelen tener mismo tamaño
+    params.pipeH   = (float)pipeGreen_->height;
+
+    // Repetición: los parámetros son los grabados, no los de ahora
+    if (replay_) {
+        params = replay_->header().params;
+    } else if (run.recordPath) {
+        ReplayHeader header;
+        header.seed   = seed;
+        header.simHz  = run.simHz;
+        header.params = params;
+        recorder_ = std::make_unique<ReplayWriter>();
+        if (!recorder_->open(run.recordPath, header, &masks)) {
+            TraceLog(LOG_WARNING, "REPLAY: no se pudo crear %s", run.recordPath);
+            recorder_.reset();
+        }
+    }
+
+    // Cada partida nueva pisa el flujo anterior, como --record
+    if (run.publishPath && !replay_) {
+        GhostHeader header;
+        header.seed  = seed;
+        header.simHz = run.simHz;
+        publisher_ = std::make_unique<GhostPublisher>(header);
+        if (!publisher_->open(run.publishPath)) {
+            TraceLog(LOG_WARNING, "GHOST: no se pudo publicar en %s (¿FIFO sin lector?)", run.publishPath);
+            publisher_.reset();
+        }
+    }
+
+    // Piloto automático: solo si no se está reproduciendo (ahí mandan los
+    // saltos grabados); graba y publica igual que un jugador
+    if (!replay_) autopilot_ = run.autopilot;
+
+    world_.reset(params, seed);
+    world_.setMasks(replay_ ? replay_->masks() : masks);
+    publish(0.0f);   // render tiene algo que dibujar antes del primer paso
+
+    // Game Over llegará tarde o temprano: que su textura ya esté decodificada
+    if (sm_->assets()) sm_->assets()->prefetch(GAMEOVER_PATH);
+}
+
+void MainGameState::listAssets(std::vector<const char*>& out) const {
+    out.insert(out.end(), BG_PATHS, BG_PATHS + 2);
+    out.push_back(GROUND_PATH);
+    out.insert(out.end(), DIGIT_PATHS, DIGIT_PATHS + 10);
+    for (int c=0;c<3;c++) out.insert(out.end(), BIRD_PATHS[c], BIRD_PATHS[c] + 3);
+    out.push_back(PIPE_GREEN_PATH);
+    out.push_back(PIPE_RED_PATH);
 }
 
 void MainGameState::handleInput() {
-    if (IsKeyPressed(KEY_SPACE)) bird_.vy += JUMP_;
-    if (IsKeyPressed(KEY_F1))    debugBoxes_ = !debugBoxes_;
+    // Cada salto viaja con el instante de su tecla: update() lo aplica en el
+    // paso que contiene ese instante, no en el primero del frame
+    const InputQueue& input = sm_->input();
+    for (int i = 0; i < input.count() && !cursor_ && !autopilot_; i++) {
+        if (input[i].key == KEY_SPACE) flaps_.push(input[i].time);
+    }
+    if (input.pressed(KEY_F1)) debugBoxes_ = !debugBoxes_;
 }
 
 void MainGameState::update(float dt) {
-    // Física del pájaro (según enunciado)
-    bird_.vy += GRAVITY_ * dt;
-    bird_.y  += bird_.vy * dt;
-    bird_.vy  = 0.0f;
-
-    // Aleteo: actualiza frame y birdSprite (cumplimos requisito de propiedad)
-    birdAnimTimer_ += dt;
-    if (birdAnimTimer_ >= 0.15f) {
-        birdAnimTimer_ = 0.0f;
-        birdFrame_ = (birdFrame_ + 1) % 3;
-        birdSprite = birdFrames_[birdColor_][birdFrame_];
-        // (tamaño se mantiene; si cambiaran, podrías re-actualizar width/height aquí)
-    }
-
-    // Salida de pantalla → Game Over
-    if (bird_.y < 0 || bird_.y + bird_.height > GetScreenHeight() - (texGround_.id ? texGround_.height : 0)) {
-        sm_->add_state(std::make_unique<GameOverState>(sm_, score_), true);
+    // Puede correr en el hilo de simulación: aquí no se llama a raylib ni se
+    // toca nada que lea render(), solo el World y lo que se publica.
+
+    // Saltos cuya tecla cae antes del final de este paso (los que llegan
+    // tarde, p. ej. con la simulación en su hilo, se aplican ya). Varios en
+    // el mismo paso cuentan como uno, como antes.
+    // Reproduciendo, los saltos son los grabados para este tick; con el
+    // piloto automático, los que decide la política sobre el estado actual.
+    const double stepEnd = stepStart() + dt;
+    bool flap = false;
+    double t;
+    if (cursor_) {
+        flap = cursor_->flapAt(tick_);
+    } else if (autopilot_) {
+        flap = autopilot_->decide(world_);
+    } else {
+        while (flaps_.peek(t) && t < stepEnd) {
+            flaps_.pop();
+            flap = true;
+            lastFlap_ = t;
+        }
+    }
+    world_.step(dt, flap);
+
+    if (recorder_) {
+        if (flap) recorder_->flap(tick_);
+        if ((tick_ + 1) % recorder_->header().hashEvery == 0) recorder_->hash(tick_, world_.stateHash());
+        if (world_.dead()) recorder_->end(tick_, world_.score());
+    }
+    if (cursor_ && !cursor_->check(tick_, world_.stateHash())) desync_ = true;
+    if (publisher_) publisher_->step(tick_, world_, flap);
+    tick_++;
+
+    // Choque o salida de pantalla → Game Over
+    if (world_.dead()) {
+        sm_->add_state(std::make_unique<GameOverState>(sm_, world_.score()), true);
         return;
     }
 
     // Scroll estético
     bgX_     -= BG_SPEED_     * dt;
     groundX_ -= GROUND_SPEED_ * dt;
-    if (bgX_     <= -texBg_[bgIdx_].width)  bgX_ = 0.0f;
-    if (groundX_ <= -texGround_.width)      groundX_ = 0.0f;
+    if (bgX_     <= -texBg_[bgIdx_]->width)  bgX_     += texBg_[bgIdx_]->width;
+    if (groundX_ <= -texGround_->width)      groundX_ += texGround_->width;
 
-    // Spawner
-    spawnTimer_ += dt;
-    if (spawnTimer_ >= spawnEvery_) {
-        spawnTimer_ = 0.0f;
-        spawnPipe();
-    }
+    publish(dt);
+}
 
-    // Mover tuberías
-    for (auto &p : pipes_) {
-        p.top.x -= PIPE_SPEED_ * dt;
-        p.bot.x -= PIPE_SPEED_ * dt;
+void MainGameState::publish(float stepDt) {
+    FrameSnapshot& s = snapshots_.back();
+    s.bird      = world_.bird();
+    s.prevBird  = world_.prevBird();
+    s.score     = world_.score();
+    s.birdFrame = world_.birdFrame();
+    s.bgX       = bgX_;
+    s.groundX   = groundX_;
+    s.stepDt    = stepDt;
+    s.tick      = tick_ > 0 ? tick_ - 1 : 0;
+    s.flapTime  = lastFlap_;
+    s.desync    = desync_;
+
+    const PipeField& pipes = world_.pipes();
+    s.pipeCount = std::min(pipes.count(), FrameSnapshot::MAX_PIPES);
+    for (int i = 0; i < s.pipeCount; i++) {
+        const PipePair& p = pipes[i];
+        s.pipes[i] = FrameSnapshot::Pipe{ pipes.x(p), p.topY, p.botY, p.red };
     }
+    snapshots_.publish();
+}
 
-    // Borrar las que salieron
-    while (!pipes_.empty() && (pipes_.front().top.x + PIPE_W < 0)) {
-        pipes_.pop_front();
+void MainGameState::drawGhosts(const FrameSnapshot& snap, float alpha, int layer) {
+    // Mismo instante que el pájaro propio: entre el paso snap.tick - 1 y
+    // snap.tick. Solo se lee del transporte cuando al decoder le falta.
+    // Con otra frecuencia de simulación, sus ticks se escalan a los nuestros.
+    SpriteBatch& batch = sm_->sprites();
+    const double simHz = sm_->runConfig().simHz;
+    const double t = (double)snap.tick - 1.0 + alpha;
+    for (const std::unique_ptr<Ghost>& g : ghosts_) {
+        const double scale = g->decoder.hasHeader() ? g->decoder.header().simHz / simHz : 1.0;
+        const double gt = std::max(0.0, t * scale);
+        const uint32_t tick = (uint32_t)gt;
+        if (g->decoder.needsData(tick + 1)) g->source.poll(g->decoder);
+        g->decoder.advanceTo(tick + 1);
+
+        float y;
+        if (!g->decoder.positionAt(tick, (float)(gt - tick), y)) continue;
+        const Sprite& s = birdFrames_[g->color][snap.birdFrame];
+        batch.draw(s, layer, (float)(int)snap.bird.x, (float)(int)y, Fade(WHITE, 0.4f));
     }
+}
 
-    // AABB del jugador (ahora por width/height)
-    Rectangle playerBB{ bird_.x, bird_.y, (float)bird_.width, (float)bird_.height };
-
-    // Colisiones + puntuación
-    for (auto &p : pipes_) {
-        if (CheckCollisionRecs(playerBB, p.top) || CheckCollisionRecs(playerBB, p.bot)) {
-            sm_->add_state(std::make_unique<GameOverState>(sm_, score_), true);
-            return;
-        }
-        if (!p.scored && (p.top.x + PIPE_W < bird_.x)) {
-            p.scored = true;
-            score_++;
-        }
-    }
+// Posición de un scroll tileado interpolada hacia atrás (1-alpha) pasos
+static float scrollAt(float x, float speed, float back, int width) {
+    x += speed * back;
+    if (x > 0.0f) x -= width;
+    return x;
 }
 
-void MainGameState::render() {
-    BeginDrawing();
+void MainGameState::render(float alpha) {
+    // El bucle principal ya tiene activo el Viewport: dibujamos en píxeles lógicos
     ClearBackground(RAYWHITE);
 
-    // Fondo (tileado)
-    DrawTexture(texBg_[bgIdx_], (int)bgX_, 0, WHITE);
-    DrawTexture(texBg_[bgIdx_], (int)bgX_ + texBg_[bgIdx_].width, 0, WHITE);
-
-    // Pájaro (lo que pide la práctica: DrawTexture con birdSprite)
-    DrawTexture(birdSprite, (int)bird_.x, (int)bird_.y, WHITE);
-
-    // Tuberías (lo que pide la práctica: DrawTextureEx con 180º en la de arriba)
-    for (const auto& p : pipes_) {
-        const Texture2D& t = p.red ? pipeRed_ : pipeGreen_;
+    // Todo el frame va al lote: se agrupa por textura dentro de cada capa
+    // (las tuberías verdes y rojas, los dígitos repetidos...) y se envía
+    // en un solo flush. Las capas mantienen el orden de antes.
+    enum Layer { LAYER_BG = 0, LAYER_GHOSTS, LAYER_BIRD, LAYER_PIPES, LAYER_GROUND, LAYER_SCORE };
+    SpriteBatch& batch = sm_->sprites();
+    batch.begin();
+    batch.keepOrder(LAYER_GHOSTS);   // translúcidos que se solapan: en su orden
+
+    // Último paso publicado por la simulación (de este hilo o del suyo)
+    snapshots_.update();
+    const FrameSnapshot& snap = snapshots_.front();
+    birdSprite = birdFrames_[birdColor_][snap.birdFrame];
+    presentedFlap_ = snap.flapTime;
+    if (snap.desync && !desyncLogged_) {
+        TraceLog(LOG_WARNING, "REPLAY: desincronizada (la huella del mundo no coincide con la grabada)");
+        desyncLogged_ = true;
+    }
 
-        // Superior → rotada 180º, con offset (x+PIPE_W, y+PIPE_H)
-        Vector2 posTop{ p.top.x + PIPE_W, p.top.y + PIPE_H };
-        DrawTextureEx(t, posTop, 180.0f, 1.0f, WHITE);
+    // Interpolación: dibujamos el instante entre los dos últimos pasos.
+    // Todo lo que se desplaza a velocidad constante se rebobina "back" segundos.
+    const float back = snap.stepDt * (1.0f - alpha);
 
-        // Inferior → normal en (x, y)
-        Vector2 posBot{ p.bot.x, p.bot.y };
-        DrawTextureEx(t, posBot, 0.0f, 1.0f, WHITE);
+    // Fondo (tileado)
+    const Sprite& bg = texBg_[bgIdx_];
+    const int bgX = (int)scrollAt(snap.bgX, BG_SPEED_, back, bg.width);
+    batch.draw(bg, LAYER_BG, (float)bgX, 0.0f);
+    batch.draw(bg, LAYER_BG, (float)(bgX + bg.width), 0.0f);
+
+    const Bird& bird = snap.bird;
+    const float birdY = snap.prevBird.y + (bird.y - snap.prevBird.y) * alpha;
+    const float PIPE_W = world_.params().pipeW;
+    const float PIPE_H = world_.params().pipeH;
+    const float pipeBack = world_.params().pipeSpeed * back;
+
+    // Fantasmas por debajo del pájaro propio; pájaro (birdSprite, como pide la práctica)
+    if (!ghosts_.empty() && snap.stepDt > 0.0f) drawGhosts(snap, alpha, LAYER_GHOSTS);
+    batch.draw(birdSprite, LAYER_BIRD, (float)(int)bird.x, (float)(int)birdY);
+
+    // Tuberías: la de arriba girada 180º sobre su propio rectángulo
+    // (equivale al DrawTextureEx con 180º y offset (x+PIPE_W, y+PIPE_H))
+    for (int i = 0; i < snap.pipeCount; i++) {
+        const FrameSnapshot::Pipe& p = snap.pipes[i];
+        const Sprite& t = p.red ? pipeRed_.get() : pipeGreen_.get();
+        const float x = p.x + pipeBack;
+
+        batch.draw(t, LAYER_PIPES, Rectangle{x, p.topY, PIPE_W, PIPE_H}, true);
+        batch.draw(t, LAYER_PIPES, Rectangle{x, p.botY, PIPE_W, PIPE_H});
     }
 
     // Suelo (tileado al fondo)
-    int groundY = GetScreenHeight() - texGround_.height;
-    DrawTexture(texGround_, (int)groundX_, groundY, WHITE);
-    DrawTexture(texGround_, (int)groundX_ + texGround_.width, groundY, WHITE);
+    const Sprite& ground = texGround_;
+    const int groundX = (int)scrollAt(snap.groundX, GROUND_SPEED_, back, ground.width);
+    const float groundY = (float)(LOGICAL_H - ground.height);
+    batch.draw(ground, LAYER_GROUND, (float)groundX, groundY);
+    batch.draw(ground, LAYER_GROUND, (float)(groundX + ground.width), groundY);
+
+    // Puntuación con sprites 0..9 (centrada arriba). Dígitos a un buffer
+    // en pila: nada de std::string por frame.
+    int digits[12];
+    int n = 0;
+    int value = snap.score;
+    do { digits[n++] = value % 10; value /= 10; } while (value > 0 && n < 12);
 
-    // Puntuación con sprites 0..9 (centrada arriba)
-    std::string s = std::to_string(score_);
     int totalW = 0;
-    for (char ch : s) totalW += texDigits_[ch-'0'].width;
-    int x = GetScreenWidth()/2 - totalW/2;
-    for (char ch : s) {
-        int d = ch - '0';
-        DrawTexture(texDigits_[d], x, 12, WHITE);
-        x += texDigits_[d].width;
+    for (int i = 0; i < n; i++) totalW += texDigits_[digits[i]]->width;
+    int x = LOGICAL_W/2 - totalW/2;
+    for (int i = n - 1; i >= 0; i--) {
+        const Sprite& d = texDigits_[digits[i]];
+        batch.draw(d, LAYER_SCORE, (float)x, 12.0f);
+        x += d.width;
     }
 
-    // Debug
+    batch.flush();
+
+    if (cursor_) DrawText("REPLAY", 8, 8, 10, snap.desync ? RED : WHITE);
+    else if (autopilot_) DrawText("AUTO", 8, 8, 10, WHITE);
+
+    // Debug (encima de todo, fuera del lote)
     if (debugBoxes_) {
-        DrawRectangleLinesEx(Rectangle{bird_.x,bird_.y,(float)bird_.width,(float)bird_.height}, 2, BLUE);
-        for (const auto& p : pipes_) {
-            DrawRectangleLinesEx(p.top, 2, RED);
-            DrawRectangleLinesEx(p.bot, 2, RED);
+        DrawRectangleLinesEx(Rectangle{bird.x,bird.y,(float)bird.width,(float)bird.height}, 2, BLUE);
+        for (int i = 0; i < snap.pipeCount; i++) {
+            const FrameSnapshot::Pipe& p = snap.pipes[i];
+            DrawRectangleLinesEx(Rectangle{p.x, p.topY, PIPE_W, PIPE_H}, 2, RED);
+            DrawRectangleLinesEx(Rectangle{p.x, p.botY, PIPE_W, PIPE_H}, 2, RED);
         }
     }
 
-    EndDrawing();
-}
-
-void MainGameState::spawnPipe() {
-    const float screenH = (float)GetScreenHeight();
-    const float groundH = texGround_.id ? (float)texGround_.height : 0.0f;
-
-    // Centro del hueco restringido por márgenes y suelo
-    const float minCenter = GAP_MARGIN_ + GAP * 0.5f;
-    const float maxCenter = screenH - groundH - GAP_MARGIN_ - GAP * 0.5f;
-    float gapCenterY = (float)GetRandomValue((int)minCenter, (int)maxCenter);
-
-    float x = (float)GetScreenWidth();
-    float topY = gapCenterY - GAP * 0.5f - PIPE_H;
-    float botY = gapCenterY + GAP * 0.5f;
-
-    PipePair pp;
-    pp.top = Rectangle{ x, topY, PIPE_W, PIPE_H };
-    pp.bot = Rectangle{ x, botY, PIPE_W, PIPE_H };
-    pp.red = GetRandomValue(0,1) == 1; // usa pipe rojo o verde
-
-    pipes_.push_back(pp);
 }
-
@@ -1,30 +1,41 @@
 #pragma once
-#include <deque>
 #include <memory>
 #include <string>
 #include <algorithm>
 
 #include "GameState.hpp"
+#include "World.hpp"
+#include "TextureCache.hpp"
+#include "TripleBuffer.hpp"
+#include "SpscRing.hpp"
+#include "Replay.hpp"
+#include "GhostStream.hpp"
+#include "Autopilot.hpp"
 class StateMachine;
 
 extern "C" {
     #include <raylib.h>
 }
 
-// x,y = esquina superior-izquierda del sprite del pájaro
-struct Bird {
-    float x{120.0f};
-    float y{200.0f};
-    float vy{0.0f};
-    int   width{0};
-    int   height{0};
-};
-
-struct PipePair {
-    Rectangle top;
-    Rectangle bot;
-    bool scored{false};
-    bool red{false};     // color de esta pareja (false=green, true=red)
+// Lo que render() necesita de un paso de simulación. update() lo rellena y
+// publica en cada paso (quizá desde el hilo de simulación) y render() dibuja
+// siempre el último publicado: nunca lee el World directamente.
+struct FrameSnapshot {
+    static constexpr int MAX_PIPES = 16;   // en pantalla caben 3 o 4 parejas
+    struct Pipe { float x, topY, botY; bool red; };
+
+    Bird bird{};
+    Bird prevBird{};
+    Pipe pipes[MAX_PIPES]{};
+    int  pipeCount{0};
+    int  score{0};
+    int  birdFrame{1};
+    float bgX{0.0f};
+    float groundX{0.0f};
+    float stepDt{0.0f};   // duración del paso (interpolación)
+    uint32_t tick{0};     // índice de ese paso (los fantasmas se dibujan en el mismo)
+    double flapTime{0.0}; // instante de la tecla del último salto aplicado (latencia)
+    bool desync{false};   // reproduciendo: la huella dejó de coincidir
 };
 
 class MainGameState : public GameState {
@@ -33,71 +44,79 @@ public:
     ~MainGameState();
 
     void init() override;   // aquí cargamos sprites y fijamos tamaños
+    void listAssets(std::vector<const char*>& out) const override;
+    const char* name() const override { return "MainGameState"; }
+    double presentedInputTime() const override { return presentedFlap_; }
     void pause() override {}
     void resume() override {}
 
     void handleInput() override;
     void update(float dt) override;
-    void render() override;
+    void render(float alpha) override;
 
 private:
-    void spawnPipe();  // generará centro y color válidos
-
     StateMachine* sm_{nullptr};
 
-    // --- Jugador
-    Bird bird_;
-
-    // Lo que pide la práctica: sprites "actuales"
-    Texture2D birdSprite{};   // frame actual del pájaro
-    Texture2D pipeSprite{};   // (no se usa para dibujar todas; mantenemos por requisito)
+    // --- Simulación (pájaro, tuberías, spawner y puntuación)
+    World world_;
+    // Saltos pendientes (instante de la tecla), del hilo principal a update()
+    SpscRing<double, 64> flaps_;
+    double lastFlap_{0.0};       // último salto aplicado (lado simulación)
+    double presentedFlap_{0.0};  // último salto ya dibujado (lado render)
+
+    // Repeticiones: tick_ cuenta los step() desde reset
+    uint32_t tick_{0};
+    std::unique_ptr<ReplayWriter> recorder_;   // --record
+    std::unique_ptr<ReplayReader> replay_;     // --replay: los saltos salen de aquí
+    std::unique_ptr<ReplayCursor> cursor_;
+    bool desync_{false};
+    bool desyncLogged_{false};
+
+    // --autopilot: los saltos los decide la política (de main; no es nuestra)
+    const Autopilot* autopilot_{nullptr};
+
+    // Partida en vivo (--publish) y fantasmas de otras (--ghost). Los
+    // fantasmas se leen y decodifican en render(), en el hilo principal.
+    std::unique_ptr<GhostPublisher> publisher_;
+    struct Ghost {
+        GhostSource source;
+        GhostDecoder decoder;
+        int color{0};
+    };
+    std::vector<std::unique_ptr<Ghost>> ghosts_;
+    void drawGhosts(const FrameSnapshot& snap, float alpha, int layer);
+
+    // Snapshots simulación → render, sin locks
+    TripleBuffer<FrameSnapshot> snapshots_;
+    void publish(float stepDt);
+
+    // Lo que pide la práctica: sprites "actuales". Son vistas (copias del
+    // Sprite) de handles de la caché: nunca se descargan desde aquí.
+    Sprite birdSprite{};   // frame actual del pájaro
+    Sprite pipeSprite{};   // (no se usa para dibujar todas; mantenemos por requisito)
 
     // Aleteo y paletas (se usan para actualizar birdSprite)
-    Texture2D birdFrames_[3][3]{}; // [color][frame] => 0:red,1:blue,2:yellow × 0:down,1:mid,2:up
+    TextureRef birdFrames_[3][3]{}; // [color][frame] => 0:red,1:blue,2:yellow × 0:down,1:mid,2:up
     int  birdColor_{0};
-    int  birdFrame_{0};
-    float birdAnimTimer_{0.0f};
 
     // Fondos, suelo y dígitos (para usar todos los PNG)
-    Texture2D texBg_[2]{};     // 0:day, 1:night
+    TextureRef texBg_[2]{};     // 0:day, 1:night
     int bgIdx_{0};
-    Texture2D texGround_{};
-    Texture2D texDigits_[10]{};
+    TextureRef texGround_{};
+    TextureRef texDigits_[10]{};
 
     // Tuberías (dos colores)
-    Texture2D pipeGreen_{};
-    Texture2D pipeRed_{};
-
-    // Cola de tuberías
-    std::deque<PipePair> pipes_;
-
-    // Spawner
-    float spawnTimer_{0.0f};
-    float spawnEvery_{1.25f}; // s (un poco más ágil)
-
-    // Física básica
-    const float GRAVITY_ = 6500.0f;
-    const float JUMP_    = -2600.0f;
-
-    // Parámetros de tuberías (ya NO const, la práctica lo pide variable)
-    float PIPE_SPEED_ = 140.0f; // px/s
-    float PIPE_W = 0.0f;        // se fija en init() con el sprite
-    float PIPE_H = 0.0f;        // se fija en init() con el sprite
-    float GAP    = 0.0f;        // se fija en init(): max(bird.h*4.5, 96)
-
-    // Márgenes para que nunca salgan imposibles
-    const float GAP_MULT_   = 5.0f;   // más generoso que 4.5
-    const float GAP_MIN_PX_ = 96.0f;
-    const float GAP_MARGIN_ = 20.0f;
+    TextureRef pipeGreen_{};
+    TextureRef pipeRed_{};
+    CollisionMask pipeTopMask_[2];   // máscaras de pipeGreen_/pipeRed_ giradas 180°
 
-    // Scroll estético
+    // Scroll estético (estado de la simulación; se publica en el snapshot)
     float bgX_{0.0f};
     float groundX_{0.0f};
     const float BG_SPEED_ = 20.0f;
     const float GROUND_SPEED_ = 140.0f;
 
-    // Puntuación y debug
-    int  score_{0};
+    // Debug
     bool debugBoxes_{false};
 };
 
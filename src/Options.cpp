@@ -0,0 +1,64 @@
+#include "Options.hpp"
+#include <cstdlib>
+#include <cstring>
+#include <cstdio>
+
+Options parseOptions(int argc, char** argv) {
+    Options o;
+    for (int i = 1; i < argc; i++) {
+        const char* a = argv[i];
+        const bool hasValue = i + 1 < argc;
+
+        if (!std::strcmp(a, "--sim-hz") && hasValue) {
+            o.simHz = std::atof(argv[++i]);
+            if (o.simHz <= 0.0) o.simHz = 240.0;
+        } else if (!std::strcmp(a, "--max-steps") && hasValue) {
+            o.maxCatchUpSteps = std::atoi(argv[++i]);
+            if (o.maxCatchUpSteps < 1) o.maxCatchUpSteps = 1;
+        } else if (!std::strcmp(a, "--sim-thread")) {
+            o.simThread = true;
+        } else if (!std::strcmp(a, "--input-latency")) {
+            o.inputLatency = true;
+        } else if (!std::strcmp(a, "--record") && hasValue) {
+            o.recordPath = argv[++i];
+        } else if (!std::strcmp(a, "--replay") && hasValue) {
+            o.replayPath = argv[++i];
+        } else if (!std::strcmp(a, "--publish") && hasValue) {
+            o.publishPath = argv[++i];
+        } else if (!std::strcmp(a, "--ghost") && hasValue) {
+            o.ghostPaths.push_back(argv[++i]);
+        } else if (!std::strcmp(a, "--autopilot")) {
+            o.autopilotPath = "assets/autopilot.txt";
+        } else if (!std::strcmp(a, "--autopilot-weights") && hasValue) {
+            o.autopilotPath = argv[++i];
+        } else if (!std::strcmp(a, "--loader-threads") && hasValue) {
+            o.loaderThreads = std::atoi(argv[++i]);
+            if (o.loaderThreads < 1) o.loaderThreads = 1;
+        } else if (!std::strcmp(a, "--upload-budget") && hasValue) {
+            o.uploadBudgetMs = std::atof(argv[++i]);
+        } else if (!std::strcmp(a, "--pack") && hasValue) {
+            o.packPath = argv[++i];
+        } else if (!std::strcmp(a, "--no-pack")) {
+            o.packPath = nullptr;
+        } else if (!std::strcmp(a, "--profile-csv") && hasValue) {
+            o.profileCsv = argv[++i];
+        } else if (!std::strcmp(a, "--alloc-check")) {
+            o.allocCheck = true;
+        } else if (!std::strcmp(a, "--alloc-warmup") && hasValue) {
+            o.allocWarmupFrames = std::atoi(argv[++i]);
+        } else if (!std::strcmp(a, "--frames") && hasValue) {
+            o.maxFrames = std::atoll(argv[++i]);
+        } else if (!std::strcmp(a, "--background-fps") && hasValue) {
+            o.backgroundFps = std::atof(argv[++i]);
+            if (o.backgroundFps <= 0.0) o.backgroundFps = 10.0;
+        } else if (!std::strcmp(a, "--scale") && hasValue) {
+            o.windowScale = std::atoi(argv[++i]);
+            if (o.windowScale < 1) o.windowScale = 1;
+        } else if (!std::strcmp(a, "--upscale") && hasValue) {
+            o.upscale = parseUpscale(argv[++i]);
+        } else {
+            std::fprintf(stderr, "Opción desconocida: %s\n", a);
+        }
+    }
+    return o;
+}
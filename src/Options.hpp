@@ -0,0 +1,28 @@
+#pragma once
+#include "Viewport.hpp"
+#include <vector>
+
+// Opciones de línea de comandos del juego
+struct Options {
+    double simHz{240.0};        // --sim-hz N      frecuencia fija de la simulación
+    int    maxCatchUpSteps{8};  // --max-steps N   pasos máximos por frame tras un tirón
+    bool   simThread{false};    // --sim-thread    simulación en su propio hilo
+    bool   inputLatency{false}; // --input-latency mide tecla → frame presentado y lo resume al salir
+    const char* recordPath{nullptr};  // --record F  graba cada partida en F (.fbr)
+    const char* replayPath{nullptr};  // --replay F  reproduce F a velocidad real
+    const char* publishPath{nullptr}; // --publish F emite la partida en vivo a F (fichero o FIFO, .fbg)
+    std::vector<const char*> ghostPaths;  // --ghost F  (repetible) dibuja esa partida como fantasma
+    const char* autopilotPath{nullptr};   // --autopilot | --autopilot-weights F  juega solo (tools/train)
+    int    loaderThreads{2};      // --loader-threads N  hilos de decodificación de PNG
+    double uploadBudgetMs{2.0};   // --upload-budget MS  tope de subidas a GPU por frame
+    const char* packPath{"assets/pack.fbpak"};  // --pack F | --no-pack  atlas de tools/packer (si falta, PNG sueltos)
+    const char* profileCsv{nullptr};  // --profile-csv F  vuelca el profiler por frame al salir
+    bool   allocCheck{false};       // --alloc-check   sale con error si un frame estable reserva
+    int    allocWarmupFrames{30};   // --alloc-warmup N  frames tras un cambio de estado que no cuentan
+    long long maxFrames{0};         // --frames N      sale tras N frames (0 = sin límite)
+    double backgroundFps{10.0};     // --background-fps N  ritmo con la ventana sin foco o minimizada (la simulación, en pausa)
+    int    windowScale{1};              // --scale N        tamaño inicial de la ventana (× resolución lógica)
+    Upscale upscale{Upscale::Integer};  // --upscale M      integer | nearest | bilinear
+};
+
+Options parseOptions(int argc, char** argv);
@@ -0,0 +1,106 @@
+#include "Profiler.hpp"
+#include <algorithm>
+#include <cstdio>
+
+const char* profPhaseName(ProfPhase phase) {
+    switch (phase) {
+        case ProfPhase::StateChanges: return "state_changes";
+        case ProfPhase::Input:        return "input";
+        case ProfPhase::Update:       return "update";
+        case ProfPhase::Render:       return "render";
+        case ProfPhase::Present:      return "present";
+        case ProfPhase::Wait:         return "wait";
+        case ProfPhase::TextureLoad:  return "texture_load";
+        case ProfPhase::Transition:   return "transition";
+        default:                      return "?";
+    }
+}
+
+const char* profCounterName(ProfCounter counter) {
+    switch (counter) {
+        case ProfCounter::Quads:           return "quads";
+        case ProfCounter::DrawCalls:       return "draw_calls";
+        case ProfCounter::TextureSwitches: return "texture_switches";
+        default:                           return "?";
+    }
+}
+
+Profiler& profiler() {
+    static Profiler instance;
+    return instance;
+}
+
+Profiler::Profiler() : ring_(HISTORY), lastEnd_(std::chrono::steady_clock::now()) {
+    for (auto& a : acc_) a.store(0, std::memory_order_relaxed);
+    for (auto& c : counters_) c.store(0, std::memory_order_relaxed);
+}
+
+void Profiler::endFrame() {
+    auto now = std::chrono::steady_clock::now();
+    const long long index = frames_.load(std::memory_order_relaxed);
+
+    Frame& f = ring_[index & (HISTORY - 1)];
+    for (int i = 0; i < PHASES; i++) {
+        f.us[i] = (float)acc_[i].exchange(0, std::memory_order_relaxed) * 1e-3f;
+    }
+    for (int i = 0; i < COUNTERS; i++) {
+        f.counters[i] = counters_[i].exchange(0, std::memory_order_relaxed);
+    }
+    f.frameUs = std::chrono::duration<float, std::micro>(now - lastEnd_).count();
+    lastEnd_ = now;
+
+    frames_.store(index + 1, std::memory_order_release);
+}
+
+Profiler::Stats Profiler::statsOf(int column, int window) const {
+    Stats s{0.0f, 0.0f, 0.0f};
+    const long long n = frameCount();
+    const int count = (int)std::min<long long>(n, std::min(window, HISTORY));
+    if (count <= 0) return s;
+
+    // Copia local en pila para ordenar (ventanas del overlay: cientos de frames)
+    float buf[1024];
+    const int m = std::min(count, 1024);
+    for (int i = 0; i < m; i++) {
+        const Frame& f = frame(n - 1 - i);
+        buf[i] = column < PHASES ? f.us[column] : f.frameUs;
+    }
+    std::sort(buf, buf + m);
+    s.p50 = buf[m / 2];
+    s.p99 = buf[std::min(m - 1, (m * 99) / 100)];
+    s.max = buf[m - 1];
+    return s;
+}
+
+Profiler::Stats Profiler::stats(ProfPhase phase, int window) const {
+    return statsOf((int)phase, window);
+}
+
+Profiler::Stats Profiler::frameStats(int window) const {
+    return statsOf(PHASES, window);
+}
+
+bool Profiler::writeCsv(const char* path) const {
+    FILE* out = std::fopen(path, "w");
+    if (!out) return false;
+
+    std::fprintf(out, "frame");
+    for (int i = 0; i < PHASES; i++) std::fprintf(out, ",%s_us", profPhaseName((ProfPhase)i));
+    std::fprintf(out, ",frame_us");
+    for (int i = 0; i < COUNTERS; i++) std::fprintf(out, ",%s", profCounterName((ProfCounter)i));
+    std::fprintf(out, "\n");
+
+    const long long n = frameCount();
+    const long long first = std::max(0LL, n - HISTORY);
+    for (long long k = first; k < n; k++) {
+        const Frame& f = frame(k);
+        std::fprintf(out, "%lld", k);
+        for (int i = 0; i < PHASES; i++) std::fprintf(out, ",%.1f", f.us[i]);
+        std::fprintf(out, ",%.1f", f.frameUs);
+        for (int i = 0; i < COUNTERS; i++) std::fprintf(out, ",%u", f.counters[i]);
+        std::fprintf(out, "\n");
+    }
+
+    std::fclose(out);
+    return true;
+}
@@ -0,0 +1,95 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <vector>
+
+// Fases de un frame que se miden por separado
+enum class ProfPhase : int {
+    StateChanges = 0,   // StateMachine::handle_state_changes
+    Input,              // handleInput
+    Update,             // todos los pasos fijos del frame
+    Render,             // render() del estado (construcción del frame)
+    Present,            // EndDrawing: flush + swap
+    Wait,               // espera hasta el siguiente frame (ritmo de FPS o estado en reposo)
+    TextureLoad,        // LoadTexture (dentro de otras fases)
+    Transition,         // pop/push/init de estados (dentro de StateChanges)
+    Count
+};
+
+// Contadores por frame (no tiempos)
+enum class ProfCounter : int {
+    Quads = 0,          // sprites enviados por SpriteBatch
+    DrawCalls,          // tandas de una misma textura (una draw call de rlgl cada una)
+    TextureSwitches,    // cambios de textura entre tandas
+    Count
+};
+
+const char* profPhaseName(ProfPhase phase);
+const char* profCounterName(ProfCounter counter);
+
+// Profiler por fases. Cada fase acumula nanosegundos en un atómico (se
+// puede medir desde cualquier hilo sin locks) y endFrame() vuelca el frame
+// en un ring buffer preasignado. El overlay y el CSV leen de ese ring.
+class Profiler {
+public:
+    static constexpr int PHASES   = (int)ProfPhase::Count;
+    static constexpr int COUNTERS = (int)ProfCounter::Count;
+    static constexpr int HISTORY  = 1 << 15;   // frames guardados (~9 min a 60 FPS)
+
+    struct Frame {
+        float us[PHASES];   // microsegundos por fase
+        float frameUs;      // duración total del frame (de endFrame a endFrame)
+        uint32_t counters[COUNTERS];
+    };
+
+    Profiler();
+
+    void add(ProfPhase phase, int64_t ns) {
+        acc_[(int)phase].fetch_add(ns, std::memory_order_relaxed);
+    }
+    void count(ProfCounter counter, int n) {
+        counters_[(int)counter].fetch_add(n, std::memory_order_relaxed);
+    }
+    void endFrame();
+
+    long long frameCount() const { return frames_.load(std::memory_order_acquire); }
+    const Frame& frame(long long index) const { return ring_[index & (HISTORY - 1)]; }
+
+    // Percentiles de una fase sobre los últimos `window` frames
+    struct Stats { float p50; float p99; float max; };
+    Stats stats(ProfPhase phase, int window) const;
+    Stats frameStats(int window) const;
+
+    bool writeCsv(const char* path) const;
+
+private:
+    Stats statsOf(int column, int window) const;
+
+    std::atomic<int64_t> acc_[PHASES];
+    std::atomic<uint32_t> counters_[COUNTERS];
+    std::vector<Frame> ring_;
+    std::atomic<long long> frames_{0};
+    std::chrono::steady_clock::time_point lastEnd_;
+};
+
+Profiler& profiler();
+
+// Mide el bloque en el que vive y lo suma a su fase
+class ProfileScope {
+public:
+    explicit ProfileScope(ProfPhase phase)
+    : phase_(phase), start_(std::chrono::steady_clock::now()) {}
+    ~ProfileScope() {
+        auto ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - start_).count();
+        profiler().add(phase_, (int64_t)ns);
+    }
+
+    ProfileScope(const ProfileScope&) = delete;
+    ProfileScope& operator=(const ProfileScope&) = delete;
+
+private:
+    ProfPhase phase_;
+    std::chrono::steady_clock::time_point start_;
+};
@@ -0,0 +1,318 @@
+#include "Replay.hpp"
+#include <cstring>
+
+namespace {
+    const char MAGIC[4] = {'F', 'B', 'R', 'P'};
+    const int BUFFER_SIZE = 64 * 1024;
+
+    // --- Cabecera: bytes little-endian sin depender del host
+    struct Bytes {
+        uint8_t data[128];
+        size_t n{0};
+
+        void u8(uint8_t v) { data[n++] = v; }
+        void u16(uint16_t v) { u8((uint8_t)v); u8((uint8_t)(v >> 8)); }
+        void u32(uint32_t v) { u16((uint16_t)v); u16((uint16_t)(v >> 16)); }
+        void u64(uint64_t v) { u32((uint32_t)v); u32((uint32_t)(v >> 32)); }
+        void f32(float v) { uint32_t b; std::memcpy(&b, &v, 4); u32(b); }
+        void f64(double v) { uint64_t b; std::memcpy(&b, &v, 8); u64(b); }
+    };
+
+    struct Parser {
+        const uint8_t* p;
+        const uint8_t* end;
+        bool ok{true};
+
+        uint8_t u8() { if (p >= end) { ok = false; return 0; } return *p++; }
+        uint16_t u16() { uint16_t lo = u8(); return (uint16_t)(lo | (u8() << 8)); }
+        uint32_t u32() { uint32_t lo = u16(); return lo | ((uint32_t)u16() << 16); }
+        uint64_t u64() { uint64_t lo = u32(); return lo | ((uint64_t)u32() << 32); }
+        float f32() { uint32_t b = u32(); float v; std::memcpy(&v, &b, 4); return v; }
+        double f64() { uint64_t b = u64(); double v; std::memcpy(&v, &b, 8); return v; }
+        uint64_t varint() {
+            uint64_t v = 0;
+            for (int shift = 0; shift < 64; shift += 7) {
+                const uint8_t b = u8();
+                v |= (uint64_t)(b & 0x7F) << shift;
+                if (!(b & 0x80)) return v;
+            }
+            ok = false;
+            return 0;
+        }
+    };
+
+    bool getMask(Parser& p, CollisionMask& mask) {
+        const int w = p.u16();
+        const int h = p.u16();
+        if (!p.ok || w == 0 || h == 0) return false;
+        mask.resize(w, h);
+        for (int y = 0; y < h && p.ok; ) {
+            const uint64_t run = p.varint();
+            if (run == 0 || run > (uint64_t)(h - y)) return false;
+            uint64_t* first = mask.row(y);
+            for (int i = 0; i < mask.words(); i++) first[i] = p.u64();
+            for (uint64_t r = 1; r < run; r++) std::memcpy(mask.row(y + (int)r), first, sizeof(uint64_t) * mask.words());
+            y += (int)run;
+        }
+        return p.ok;
+    }
+
+    // Mismo orden al escribir y al leer
+    template <typename Io, typename F, typename I>
+    void paramsFields(WorldParams& w, Io& io, F f32, I i32) {
+        f32(io, w.screenW);    f32(io, w.screenH);    f32(io, w.groundH);
+        i32(io, w.birdW);      i32(io, w.birdH);
+        f32(io, w.pipeW);      f32(io, w.pipeH);
+        f32(io, w.birdStartX); f32(io, w.birdStartYFrac);
+        f32(io, w.gravity);    f32(io, w.jump);       f32(io, w.physicsHz);
+        f32(io, w.pipeSpeed);  f32(io, w.spawnEvery);
+        f32(io, w.gapMult);    f32(io, w.gapMinPx);   f32(io, w.gapMargin);
+    }
+}
+
+// --- ReplayWriter
+
+bool ReplayWriter::open(const char* path, const ReplayHeader& header, const CollisionMasks* masks) {
+    close();
+    out_ = std::fopen(path, "wb");
+    if (!out_) return false;
+
+    buffer_.resize(BUFFER_SIZE);
+    std::setvbuf(out_, buffer_.data(), _IOFBF, buffer_.size());
+
+    header_ = header;
+    if (header_.hashEvery == 0) header_.hashEvery = 1;
+    lastTick_ = 0;
+
+    Bytes b;
+    for (char c : MAGIC) b.u8((uint8_t)c);
+    b.u16(header_.version);
+    b.u16(header_.hashEvery);
+    b.u32(header_.seed);
+    b.f64(header_.simHz);
+    paramsFields(header_.params, b,
+                 [](Bytes& o, float v) { o.f32(v); },
+                 [](Bytes& o, int v) { o.u32((uint32_t)v); });
+    const bool withMasks = masks && masks->valid();
+    b.u8(withMasks ? 1 : 0);
+    std::fwrite(b.data, 1, b.n, out_);
+
+    // Las de arriba son las de abajo giradas: no se guardan
+    if (withMasks) {
+        for (const CollisionMask* m : masks->bird) putMask(*m);
+        for (const CollisionMask* m : masks->pipe) putMask(*m);
+    }
+    return true;
+}
+
+void ReplayWriter::putMask(const CollisionMask& mask) {
+    const uint8_t dims[4] = { (uint8_t)mask.width(), (uint8_t)(mask.width() >> 8),
+                              (uint8_t)mask.height(), (uint8_t)(mask.height() >> 8) };
+    std::fwrite(dims, 1, 4, out_);
+
+    // Filas iguales seguidas (el cuerpo de una tubería) van una sola vez
+    const size_t rowBytes = sizeof(uint64_t) * mask.words();
+    for (int y = 0; y < mask.height(); ) {
+        int run = 1;
+        while (y + run < mask.height() && !std::memcmp(mask.row(y), mask.row(y + run), rowBytes)) run++;
+        putVarint((uint64_t)run);
+        for (int i = 0; i < mask.words(); i++) {
+            const uint64_t v = mask.row(y)[i];
+            putU32((uint32_t)v);
+            putU32((uint32_t)(v >> 32));
+        }
+        y += run;
+    }
+}
+
+void ReplayWriter::putVarint(uint64_t v) {
+    while (v >= 0x80) {
+        std::fputc((int)((v & 0x7F) | 0x80), out_);
+        v >>= 7;
+    }
+    std::fputc((int)v, out_);
+}
+
+void ReplayWriter::putU32(uint32_t v) {
+    const uint8_t b[4] = { (uint8_t)v, (uint8_t)(v >> 8), (uint8_t)(v >> 16), (uint8_t)(v >> 24) };
+    std::fwrite(b, 1, 4, out_);
+}
+
+void ReplayWriter::putEvent(ReplayEventKind kind, uint32_t tick) {
+    putVarint(((uint64_t)(tick - lastTick_) << 2) | (uint64_t)kind);
+    lastTick_ = tick;
+}
+
+void ReplayWriter::flap(uint32_t tick) {
+    if (!out_) return;
+    putEvent(ReplayEventKind::Flap, tick);
+}
+
+void ReplayWriter::hash(uint32_t tick, uint32_t hash) {
+    if (!out_) return;
+    putEvent(ReplayEventKind::Hash, tick);
+    putU32(hash);
+}
+
+void ReplayWriter::end(uint32_t tick, int score) {
+    if (!out_) return;
+    putEvent(ReplayEventKind::End, tick);
+    putVarint((uint64_t)(score < 0 ? 0 : score));
+    close();
+}
+
+void ReplayWriter::close() {
+    if (out_) {
+        std::fclose(out_);
+        out_ = nullptr;
+    }
+}
+
+// --- ReplayReader
+
+bool ReplayReader::open(const char* path) {
+    data_.clear();
+    FILE* in = std::fopen(path, "rb");
+    if (!in) return false;
+
+    uint8_t chunk[BUFFER_SIZE];
+    size_t n;
+    while ((n = std::fread(chunk, 1, sizeof(chunk), in)) > 0) data_.insert(data_.end(), chunk, chunk + n);
+    std::fclose(in);
+
+    Parser p{ data_.data(), data_.data() + data_.size() };
+    for (char c : MAGIC) if (p.u8() != (uint8_t)c) return false;
+    header_.version   = p.u16();
+    header_.hashEvery = p.u16();
+    header_.seed      = p.u32();
+    header_.simHz     = p.f64();
+    paramsFields(header_.params, p,
+                 [](Parser& i, float& v) { v = i.f32(); },
+                 [](Parser& i, int& v) { v = (int)i.u32(); });
+    if (!p.ok || header_.version != ReplayHeader{}.version || header_.simHz <= 0.0) return false;
+
+    masks_ = CollisionMasks{};
+    if (p.u8() == 1) {
+        for (auto& m : bird_) if (!getMask(p, m)) return false;
+        for (auto& m : pipe_) if (!getMask(p, m)) return false;
+        for (int c = 0; c < 2; c++) {
+            pipeTop_[c] = pipe_[c].rotated180();
+            masks_.pipe[c] = &pipe_[c];
+            masks_.pipeTop[c] = &pipeTop_[c];
+        }
+        for (int f = 0; f < 3; f++) masks_.bird[f] = &bird_[f];
+    }
+    if (!p.ok) return false;
+
+    events_ = (size_t)(p.p - data_.data());
+    rewind();
+    return true;
+}
+
+void ReplayReader::rewind() {
+    pos_ = events_;
+    lastTick_ = 0;
+}
+
+bool ReplayReader::getVarint(uint64_t& v) {
+    v = 0;
+    for (int shift = 0; shift < 64; shift += 7) {
+        if (pos_ >= data_.size()) return false;
+        const uint8_t b = data_[pos_++];
+        v |= (uint64_t)(b & 0x7F) << shift;
+        if (!(b & 0x80)) return true;
+    }
+    return false;
+}
+
+bool ReplayReader::next(ReplayEvent& e) {
+    uint64_t tag;
+    if (!getVarint(tag)) return false;
+
+    e.kind = (ReplayEventKind)(tag & 0x3);
+    e.tick = lastTick_ + (uint32_t)(tag >> 2);
+    e.value = 0;
+    lastTick_ = e.tick;
+
+    switch (e.kind) {
+        case ReplayEventKind::Flap:
+            return true;
+        case ReplayEventKind::Hash: {
+            if (pos_ + 4 > data_.size()) return false;
+            const uint8_t* b = &data_[pos_];
+            e.value = (uint32_t)b[0] | ((uint32_t)b[1] << 8) | ((uint32_t)b[2] << 16) | ((uint32_t)b[3] << 24);
+            pos_ += 4;
+            return true;
+        }
+        case ReplayEventKind::End: {
+            uint64_t score;
+            if (!getVarint(score)) return false;
+            e.value = (uint32_t)score;
+            return true;
+        }
+        default:
+            return false;
+    }
+}
+
+// --- ReplayCursor
+
+ReplayCursor::ReplayCursor(ReplayReader& reader) : reader_(reader) {
+    advance();
+}
+
+void ReplayCursor::advance() {
+    has_ = reader_.next(ev_);
+}
+
+bool ReplayCursor::flapAt(uint32_t tick) {
+    bool flap = false;
+    while (has_ && ev_.tick == tick && ev_.kind == ReplayEventKind::Flap) {
+        flap = true;
+        advance();
+    }
+    return flap;
+}
+
+bool ReplayCursor::check(uint32_t tick, uint32_t worldHash) {
+    bool ok = true;
+    while (has_ && ev_.tick <= tick) {
+        if (ev_.kind == ReplayEventKind::Hash && ev_.value != worldHash && ev_.tick == tick) ok = false;
+        if (ev_.kind == ReplayEventKind::End) {
+            ended_ = true;
+            endTick_ = ev_.tick;
+            endScore_ = (int)ev_.value;
+        }
+        advance();
+    }
+    return ok;
+}
+
+// --- Reproducción headless
+
+ReplayResult runReplay(ReplayReader& reader) {
+    ReplayResult r;
+    reader.rewind();
+    const ReplayHeader& h = reader.header();
+    r.hashEvery = h.hashEvery;
+    const float dt = (float)(1.0 / h.simHz);
+
+    World world;
+    world.reset(h.params, h.seed);
+    world.setMasks(reader.masks());
+    ReplayCursor cursor(reader);
+
+    for (uint32_t tick = 0; !world.dead() && !cursor.ended(); tick++) {
+        world.step(dt, cursor.flapAt(tick));
+        r.ticks = tick + 1;
+        if (!cursor.check(tick, world.stateHash()) && !r.desync) {
+            r.desync = true;
+            r.desyncTick = tick;
+        }
+    }
+
+    r.score = world.score();
+    r.died = world.dead();
+    if (cursor.ended()) r.recordedScore = cursor.endScore();
+    return r;
+}
@@ -0,0 +1,136 @@
+#pragma once
+#include "World.hpp"
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+
+// Repeticiones: semilla + parámetros del mundo + los ticks en que hubo salto.
+// Con eso World reproduce la partida exacta (es determinista).
+//
+// Formato (.fbr, little-endian):
+//   cabecera  "FBRP", u16 versión, u16 hashEvery, u32 semilla, f64 simHz,
+//             WorldParams campo a campo (f32/i32)
+//   máscaras  u8 (1 si la partida usó colisión por píxel) y, si la hay, las
+//             del pájaro (3 frames) y tuberías (verde, roja): u16 ancho,
+//             u16 alto y filas en RLE: varint(repeticiones) + palabras u64
+//   eventos   varint((tick - tickEventoAnterior) << 2 | tipo)
+//             tipo 0 salto · 1 huella (+u32) · 2 fin (+varint puntuación)
+// Cada hashEvery ticks va la huella del mundo (World::stateHash) para
+// detectar desincronizaciones al reproducir. Por defecto en todos: son 5
+// bytes por tick (~1.2 KB/s a 240 Hz) y la desincronización se ve en el
+// tick exacto; con hashEvery > 1 solo se sabe en qué ventana fue.
+//
+// Versión 2: tuberías y aspecto salen de CounterRng (la 1 usaba xorshift y
+// ya no se puede reproducir). Versión 3: máscaras de colisión.
+struct ReplayHeader {
+    uint16_t version{3};
+    uint16_t hashEvery{1};
+    uint32_t seed{0};
+    double   simHz{240.0};
+    WorldParams params{};
+};
+
+enum class ReplayEventKind : uint8_t { Flap = 0, Hash = 1, End = 2 };
+
+struct ReplayEvent {
+    ReplayEventKind kind;
+    uint32_t tick;    // paso (0 = el primer step tras reset)
+    uint32_t value;   // huella o puntuación final
+};
+
+// Escritura en streaming durante la partida: todo pasa por un buffer de
+// FILE propio, así que un evento cuesta unos bytes de memcpy y no una
+// llamada al sistema.
+class ReplayWriter {
+public:
+    ReplayWriter() = default;
+    ~ReplayWriter() { close(); }
+
+    ReplayWriter(const ReplayWriter&) = delete;
+    ReplayWriter& operator=(const ReplayWriter&) = delete;
+
+    // masks: las de la partida si usa colisión por píxel (World::setMasks)
+    bool open(const char* path, const ReplayHeader& header, const CollisionMasks* masks = nullptr);
+    bool isOpen() const { return out_ != nullptr; }
+    const ReplayHeader& header() const { return header_; }
+
+    void flap(uint32_t tick);
+    void hash(uint32_t tick, uint32_t hash);
+    void end(uint32_t tick, int score);   // cierra el fichero
+    void close();
+
+private:
+    void putEvent(ReplayEventKind kind, uint32_t tick);
+    void putVarint(uint64_t v);
+    void putU32(uint32_t v);
+    void putMask(const CollisionMask& mask);
+
+    FILE* out_{nullptr};
+    ReplayHeader header_{};
+    uint32_t lastTick_{0};
+    std::vector<char> buffer_;
+};
+
+// Lectura: el fichero entero a memoria y se recorre evento a evento
+class ReplayReader {
+public:
+    bool open(const char* path);
+    const ReplayHeader& header() const { return header_; }
+    const CollisionMasks& masks() const { return masks_; }   // valid() si se grabaron
+
+    bool next(ReplayEvent& e);   // false al acabar (o si está truncado)
+    void rewind();
+    size_t bytes() const { return data_.size(); }
+
+private:
+    bool getVarint(uint64_t& v);
+
+    ReplayHeader header_{};
+    CollisionMask bird_[3];
+    CollisionMask pipe_[2];
+    CollisionMask pipeTop_[2];
+    CollisionMasks masks_{};
+    std::vector<uint8_t> data_;
+    size_t events_{0};   // offset del primer evento
+    size_t pos_{0};
+    uint32_t lastTick_{0};
+};
+
+// Recorre los eventos al ritmo de la simulación (headless o en el juego)
+class ReplayCursor {
+public:
+    explicit ReplayCursor(ReplayReader& reader);
+
+    bool flapAt(uint32_t tick);   // antes de step(tick)
+
+    // Después de step(tick): compara las huellas grabadas para este tick.
+    // Devuelve false si alguna no coincide.
+    bool check(uint32_t tick, uint32_t worldHash);
+
+    bool ended() const { return ended_; }          // ya se pasó el evento de fin
+    uint32_t endTick() const { return endTick_; }
+    int endScore() const { return endScore_; }
+
+private:
+    void advance();
+
+    ReplayReader& reader_;
+    ReplayEvent ev_{};
+    bool has_{false};
+    bool ended_{false};
+    uint32_t endTick_{0};
+    int endScore_{0};
+};
+
+struct ReplayResult {
+    uint32_t ticks{0};          // pasos simulados
+    int      score{0};
+    bool     died{false};
+    bool     desync{false};
+    uint32_t desyncTick{0};     // primer tick con huella distinta
+    uint16_t hashEvery{1};      // el desvío está en los hashEvery ticks hasta desyncTick
+    int      recordedScore{-1}; // la del evento de fin (-1 si no hay)
+};
+
+// Reproduce sin ventana tan rápido como se pueda
+ReplayResult runReplay(ReplayReader& reader);
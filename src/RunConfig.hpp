@@ -0,0 +1,14 @@
+#pragma once
+#include <vector>
+class Autopilot;
+
+// Ajustes de partida que vienen de la línea de comandos y que cada
+// MainGameState nuevo (también los de reinicio) tiene que ver. Lo posee main.
+struct RunConfig {
+    double      simHz{240.0};          // frecuencia de los pasos (va en la grabación)
+    const char* recordPath{nullptr};   // graba cada partida aquí (la nueva pisa a la anterior)
+    const char* replayPath{nullptr};   // reproduce esta grabación en vez de leer el teclado
+    const char* publishPath{nullptr};  // emite cada partida en vivo (GhostStream)
+    std::vector<const char*> ghostPaths;   // partidas ajenas que se dibujan como fantasmas
+    const Autopilot* autopilot{nullptr};   // juega la política en vez del teclado (y reinicia sola)
+};
@@ -0,0 +1,67 @@
+#include "SimThread.hpp"
+#include "GameState.hpp"
+#include "StateMachine.hpp"
+#include "Profiler.hpp"
+#include <algorithm>
+
+SimThread::SimThread(StateMachine& sm, double hz, int maxCatchUpSteps)
+: sm_(sm), step_(1.0 / hz), maxCatchUpSteps_(std::max(1, maxCatchUpSteps)) {}
+
+SimThread::~SimThread() {
+    stop();
+}
+
+void SimThread::start(GameState* state) {
+    stop();
+    lastStepNs_.store(Clock::now().time_since_epoch().count(), std::memory_order_relaxed);
+    run_.store(true, std::memory_order_release);
+    thread_ = std::thread(&SimThread::loop, this, state);
+}
+
+void SimThread::stop() {
+    run_.store(false, std::memory_order_release);
+    if (thread_.joinable()) thread_.join();
+}
+
+float SimThread::alpha() const {
+    const int64_t last = lastStepNs_.load(std::memory_order_relaxed);
+    const double since = std::chrono::duration<double>(
+        Clock::now() - Clock::time_point(Clock::duration(last))).count();
+    return (float)std::min(1.0, std::max(0.0, since / step_.count()));
+}
+
+void SimThread::loop(GameState* state) {
+    const auto step = std::chrono::duration_cast<Clock::duration>(step_);
+    const auto maxLag = step * maxCatchUpSteps_;
+    auto next = Clock::now() + step;
+
+    while (run_.load(std::memory_order_acquire)) {
+        std::this_thread::sleep_until(next);
+
+        // Tras un tirón (depurador, portátil suspendido) no intentamos
+        // recuperar más de maxCatchUpSteps pasos: el resto se descarta
+        auto now = Clock::now();
+        if (now - next > maxLag) {
+            dropped_ += std::chrono::duration<double>(now - next - maxLag).count();
+            next = now - maxLag;
+        }
+
+        // Cambio pedido: el estado ya no simula hasta que main lo aplique
+        if (sm_.has_pending_changes()) {
+            next = now + step;
+            continue;
+        }
+
+        ProfileScope prof(ProfPhase::Update);
+        const auto t0 = Clock::now();
+        while (next <= now && !sm_.has_pending_changes()) {
+            // El paso que acaba en `next` empezó un paso antes
+            state->setStepStart(std::chrono::duration<double>((next - step).time_since_epoch()).count());
+            state->update(dt());
+            lastStepNs_.store(next.time_since_epoch().count(), std::memory_order_relaxed);
+            next += step;
+            totalSteps_++;
+        }
+        simSeconds_ += std::chrono::duration<double>(Clock::now() - t0).count();
+    }
+}
@@ -0,0 +1,56 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <thread>
+
+class GameState;
+class StateMachine;
+
+// Simulación en su propio hilo a paso fijo. Llama a update() del estado a
+// ritmo constante (sleep hasta el siguiente paso) sin depender de lo que
+// tarde el render ni de la espera de vsync en EndDrawing. El estado publica
+// lo que haya que dibujar por su cuenta (snapshots); este hilo no toca
+// raylib.
+//
+// Las transiciones las aplica siempre el hilo principal: en cuanto el
+// estado pide un cambio el hilo deja de simular, y el bucle principal lo
+// para con stop() antes de handle_state_changes.
+class SimThread {
+public:
+    SimThread(StateMachine& sm, double hz, int maxCatchUpSteps);
+    ~SimThread();
+
+    SimThread(const SimThread&) = delete;
+    SimThread& operator=(const SimThread&) = delete;
+
+    void start(GameState* state);
+    void stop();
+    bool running() const { return thread_.joinable(); }
+
+    float dt() const { return (float)step_.count(); }
+
+    // Fracción del paso actual que ya ha transcurrido (para interpolar)
+    float alpha() const;
+
+    // Métricas (leer con el hilo parado)
+    long long totalSteps() const { return totalSteps_; }
+    double    simSeconds() const { return simSeconds_; }
+    double    droppedTime() const { return dropped_; }
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    void loop(GameState* state);
+
+    StateMachine& sm_;
+    std::chrono::duration<double> step_;
+    int maxCatchUpSteps_;
+
+    std::thread thread_;
+    std::atomic<bool> run_{false};
+    std::atomic<int64_t> lastStepNs_{0};   // instante del último paso (steady_clock)
+
+    long long totalSteps_{0};
+    double    simSeconds_{0.0};
+    double    dropped_{0.0};
+};
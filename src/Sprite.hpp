@@ -0,0 +1,21 @@
+#pragma once
+
+extern "C" {
+    #include <raylib.h>
+}
+
+// Lo que se dibuja: un trozo de una textura de GPU. Con PNG sueltos es la
+// textura entera; con el pack (AssetPack) todos comparten la del atlas y
+// solo cambia src. width/height son los del sprite, no los de tex.
+struct Sprite {
+    Texture2D tex{};
+    Rectangle src{};
+    int width{0};
+    int height{0};
+
+    bool valid() const { return tex.id != 0; }
+};
+
+inline Sprite wholeTexture(const Texture2D& tex) {
+    return Sprite{tex, Rectangle{0.0f, 0.0f, (float)tex.width, (float)tex.height}, tex.width, tex.height};
+}
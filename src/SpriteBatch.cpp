@@ -0,0 +1,90 @@
+#include "SpriteBatch.hpp"
+#include "Profiler.hpp"
+#include <algorithm>
+
+extern "C" {
+    #include <rlgl.h>
+}
+
+void SpriteBatch::begin() {
+    count_ = 0;
+    ordered_[0] = ordered_[1] = ordered_[2] = ordered_[3] = 0;
+}
+
+void SpriteBatch::draw(const Texture2D& tex, int layer, float x, float y, Color tint) {
+    draw(tex, layer, Rectangle{0.0f, 0.0f, (float)tex.width, (float)tex.height},
+         Rectangle{x, y, (float)tex.width, (float)tex.height}, false, tint);
+}
+
+void SpriteBatch::draw(const Texture2D& tex, int layer, Rectangle src, Rectangle dst,
+                       bool rotated180, Color tint) {
+    if (!tex.id || tex.width <= 0 || tex.height <= 0) return;
+    if (count_ == MAX_QUADS) flush();   // no debería pasar; mejor flush que perder sprites
+
+    Quad& q = quads_[count_];
+    q.texId = tex.id;
+    q.u0 = src.x / tex.width;
+    q.v0 = src.y / tex.height;
+    q.u1 = (src.x + src.width) / tex.width;
+    q.v1 = (src.y + src.height) / tex.height;
+    if (rotated180) {   // girar 180º = invertir ambas coordenadas de textura
+        std::swap(q.u0, q.u1);
+        std::swap(q.v0, q.v1);
+    }
+    q.dst = dst;
+    q.tint = tint;
+
+    // Orden: capa (8 bits) | textura (24 bits) | llegada (32 bits). En las
+    // capas con keepOrder la textura no cuenta: queda solo la llegada.
+    const int l = layer & 0xFF;
+    const bool ordered = (ordered_[l >> 6] >> (l & 63)) & 1u;
+    keys_[count_] = ((uint64_t)l << 56) |
+                    (ordered ? 0 : (uint64_t)(tex.id & 0xFFFFFF) << 32) |
+                    (uint64_t)count_;
+    count_++;
+}
+
+void SpriteBatch::flush() {
+    stats_ = Stats{count_, 0, 0};
+    if (count_ == 0) return;
+
+    std::sort(keys_, keys_ + count_);
+
+    unsigned int current = 0;
+    bool open = false;
+    for (int k = 0; k < count_; k++) {
+        const Quad& q = quads_[keys_[k] & 0xFFFFFFFFu];
+
+        if (!open || q.texId != current) {
+            if (open) {
+                rlEnd();
+                stats_.textureSwitches++;
+            }
+            rlSetTexture(q.texId);
+            rlBegin(RL_QUADS);
+            current = q.texId;
+            open = true;
+            stats_.drawCalls++;
+        }
+
+        const float x0 = q.dst.x, y0 = q.dst.y;
+        const float x1 = q.dst.x + q.dst.width, y1 = q.dst.y + q.dst.height;
+
+        rlColor4ub(q.tint.r, q.tint.g, q.tint.b, q.tint.a);
+        rlNormal3f(0.0f, 0.0f, 1.0f);
+        rlTexCoord2f(q.u0, q.v0); rlVertex2f(x0, y0);
+        rlTexCoord2f(q.u0, q.v1); rlVertex2f(x0, y1);
+        rlTexCoord2f(q.u1, q.v1); rlVertex2f(x1, y1);
+        rlTexCoord2f(q.u1, q.v0); rlVertex2f(x1, y0);
+    }
+    if (open) {
+        rlEnd();
+        rlSetTexture(0);
+    }
+
+    profiler().count(ProfCounter::Quads, stats_.quads);
+    profiler().count(ProfCounter::DrawCalls, stats_.drawCalls);
+    profiler().count(ProfCounter::TextureSwitches, stats_.textureSwitches);
+
+    count_ = 0;
+}
@@ -0,0 +1,66 @@
+#pragma once
+#include <cstdint>
+#include "Sprite.hpp"
+
+extern "C" {
+    #include <raylib.h>
+}
+
+// Lote de sprites del frame sobre rlgl. Se apilan quads con su capa; flush()
+// los ordena por (capa, textura) manteniendo el orden de llegada dentro de
+// cada grupo y los envía en tandas: una rlSetTexture + rlBegin/rlEnd por
+// cada racha de la misma textura, que rlgl junta en una sola draw call.
+// Dentro de una capa el orden entre texturas distintas no se garantiza:
+// en una misma capa solo van sprites opacos que no se solapan, salvo en las
+// marcadas con keepOrder() (translúcidos: ahí el orden cambia la mezcla).
+class SpriteBatch {
+public:
+    static constexpr int MAX_QUADS = 1024;
+
+    struct Stats {
+        int quads;
+        int drawCalls;        // rachas de una misma textura
+        int textureSwitches;  // cambios de textura entre rachas
+    };
+
+    void begin();   // también olvida los keepOrder() del frame anterior
+
+    // La capa se dibuja en el orden de llegada, sin agrupar por textura
+    // (más draw calls si alternan texturas). Tras begin(), antes de dibujar.
+    void keepOrder(int layer) { ordered_[(layer & 0xFF) >> 6] |= 1ull << (layer & 63); }
+
+    // Sprite completo en (x, y) sin escalar, como DrawTexture
+    void draw(const Texture2D& tex, int layer, float x, float y, Color tint = WHITE);
+
+    // Trozo src de la textura en el rectángulo dst; rotated180 lo gira sobre
+    // su centro (lo que hacía DrawTextureEx con 180º para la tubería de arriba)
+    void draw(const Texture2D& tex, int layer, Rectangle src, Rectangle dst,
+              bool rotated180 = false, Color tint = WHITE);
+
+    // Lo mismo con sprites (su trozo de textura, que puede ser del atlas)
+    void draw(const Sprite& sprite, int layer, float x, float y, Color tint = WHITE) {
+        draw(sprite.tex, layer, sprite.src,
+             Rectangle{x, y, (float)sprite.width, (float)sprite.height}, false, tint);
+    }
+    void draw(const Sprite& sprite, int layer, Rectangle dst, bool rotated180 = false, Color tint = WHITE) {
+        draw(sprite.tex, layer, sprite.src, dst, rotated180, tint);
+    }
+
+    void flush();
+
+    const Stats& stats() const { return stats_; }   // del último flush
+
+private:
+    struct Quad {
+        unsigned int texId;
+        float u0, v0, u1, v1;   // coordenadas de textura ya normalizadas
+        Rectangle dst;
+        Color tint;
+    };
+
+    Quad quads_[MAX_QUADS];
+    uint64_t keys_[MAX_QUADS];   // capa | textura | orden de llegada
+    uint64_t ordered_[4]{};      // bit por capa: keepOrder()
+    int count_{0};
+    Stats stats_{0, 0, 0};
+};
@@ -0,0 +1,38 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+
+// Cola circular sin locks de capacidad fija para un productor y un
+// consumidor (p. ej. eventos del hilo principal al de simulación).
+// N potencia de 2. Si está llena, push() falla en vez de esperar.
+template <typename T, int N>
+class SpscRing {
+    static_assert(N > 0 && (N & (N - 1)) == 0, "SpscRing: N debe ser potencia de 2");
+
+public:
+    // --- Productor
+    bool push(const T& value) {
+        const uint32_t head = head_.load(std::memory_order_relaxed);
+        if (head - tail_.load(std::memory_order_acquire) == (uint32_t)N) return false;
+        slots_[head & (N - 1)] = value;
+        head_.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    // --- Consumidor
+    bool peek(T& out) const {
+        const uint32_t tail = tail_.load(std::memory_order_relaxed);
+        if (tail == head_.load(std::memory_order_acquire)) return false;
+        out = slots_[tail & (N - 1)];
+        return true;
+    }
+
+    void pop() {
+        tail_.store(tail_.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    }
+
+private:
+    T slots_[N]{};
+    alignas(64) std::atomic<uint32_t> head_{0};   // lo escribe el productor
+    alignas(64) std::atomic<uint32_t> tail_{0};   // lo escribe el consumidor
+};
@@ -1,4 +1,5 @@
 #include <StateMachine.hpp>
+#include "Profiler.hpp"
 #include <iostream>
 
 StateMachine::StateMachine()
@@ -8,46 +9,95 @@ StateMachine::StateMachine()
 
 void StateMachine::add_state(std::unique_ptr<GameState> newState, bool is_replacing)
 {
-    is_Adding = true;
+    newState->setStateMachine(this);
+
+    std::lock_guard<std::mutex> lock(this->pending_mutex);
     this->is_Replacing = is_replacing;
     this->new_state = std::move(newState);
-    this->new_state->setStateMachine(this);
+    this->assets_requested = false;
+    this->is_Adding.store(true, std::memory_order_release);
+}
+
+bool StateMachine::new_state_ready()
+{
+    if (!this->asset_provider) return true;
+
+    // Pedir sus assets la primera vez que se mira (ya en el hilo principal:
+    // el provider consulta la caché): se decodifican en segundo plano
+    // mientras sigue el estado actual
+    if (!this->assets_requested)
+    {
+        this->pending_assets.clear();
+        this->new_state->listAssets(this->pending_assets);
+        for (const char* path : this->pending_assets) this->asset_provider->prefetch(path);
+        this->assets_requested = true;
+    }
+
+    for (const char* path : this->pending_assets)
+    {
+        if (!this->asset_provider->isReady(path)) return false;
+    }
+    return true;
 }
 
 void StateMachine::remove_state(bool value)
 {
-    this->is_removing = true;
+    std::lock_guard<std::mutex> lock(this->pending_mutex);
     this->is_ending = value;
+    this->is_removing.store(true, std::memory_order_release);
 }
 
-void StateMachine::handle_state_changes(float& deltaTime)
+bool StateMachine::handle_state_changes(float& deltaTime)
 {
-    if (this->is_removing && !this->states_machine.empty())
+    bool changed = false;
+    if (!this->has_pending_changes()) return changed;
+
+    // Se saca la petición bajo el lock (quizá la hizo el hilo de simulación)
+    // y se aplica fuera: init() puede pedir a su vez otro cambio
+    std::unique_ptr<GameState> adding;
+    bool removing, replacing;
+    {
+        std::lock_guard<std::mutex> lock(this->pending_mutex);
+
+        // Activación diferida: el estado nuevo espera a tener sus texturas
+        if (this->is_Adding && !this->new_state_ready()) return changed;
+
+        adding = std::move(this->new_state);
+        removing = this->is_removing;
+        replacing = this->is_Replacing;
+        this->is_Adding.store(false, std::memory_order_release);
+        this->is_removing.store(false, std::memory_order_release);
+    }
+
+    ProfileScope prof(ProfPhase::Transition);
+
+    if (removing && !this->states_machine.empty())
     {
         this->states_machine.pop();
-        this->is_removing = false;
+        changed = true;
 
-        if (!this->is_Adding)
+        if (!adding && !this->states_machine.empty())
         {
             this->states_machine.top()->resume();
             deltaTime = 0.0f;
         }
     }
 
-    if (this->is_Adding)
+    if (adding)
     {
         if(!this->states_machine.empty())
         {
-            if (this->is_Replacing)
+            if (replacing)
             {
                 this->states_machine.pop();
             }
         }
 
-        this->states_machine.push(std::move(this->new_state));
+        this->states_machine.push(std::move(adding));
         this->states_machine.top()->init();
-        this->is_Adding = false;
         deltaTime = 0.0f;
+        changed = true;
     }
-}
 
+    return changed;
+}
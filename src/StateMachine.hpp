@@ -4,6 +4,24 @@
 #include <memory>
 #include <unordered_map>
 #include <string>
+#include <vector>
+#include <atomic>
+#include <mutex>
+#include "RunConfig.hpp"
+
+class TextureCache;
+class SpriteBatch;
+class InputQueue;
+
+// Quien sepa cargar assets en segundo plano (AssetLoader). StateMachine no
+// sabe de raylib: solo pregunta si las rutas que pide un estado están listas.
+class AssetProvider
+{
+    public:
+        virtual ~AssetProvider() = default;
+        virtual void prefetch(const char* path) = 0;
+        virtual bool isReady(const char* path) const = 0;
+};
 
 class StateMachine 
 {
@@ -11,9 +29,13 @@ class StateMachine
         StateMachine();
         ~StateMachine() = default;
 
+        // add_state/remove_state se pueden pedir desde el hilo de simulación;
+        // el resto (y aplicar los cambios) solo desde el hilo principal
         void add_state(std::unique_ptr<GameState> state, bool is_replacing);
         void remove_state(bool value);
-        void handle_state_changes(float& deltaTime);
+        // Aplica el cambio pendiente; devuelve true si la pila cambió
+        bool handle_state_changes(float& deltaTime);
+        bool has_pending_changes() const {return this->is_Adding.load(std::memory_order_acquire) || this->is_removing.load(std::memory_order_acquire);}
 
         void stop() {is_running = false;}
         bool isRunning() {return this->is_running;}
@@ -21,14 +43,47 @@ class StateMachine
         bool is_game_ending() {return this->is_ending;}
 
         std::unique_ptr<GameState>& getCurrentState() {return this->states_machine.top();}
+
+        // Caché de texturas compartida entre estados (la posee main)
+        void setTextureCache(TextureCache* cache) {texture_cache = cache;}
+        TextureCache& textures() {return *this->texture_cache;}
+
+        // Lote de sprites del frame (lo posee main: no cabe en un slot de estado)
+        void setSpriteBatch(SpriteBatch* batch) {sprite_batch = batch;}
+        SpriteBatch& sprites() {return *this->sprite_batch;}
+
+        // Teclas del frame con su instante (la posee main)
+        void setInput(InputQueue* input) {input_queue = input;}
+        const InputQueue& input() {return *this->input_queue;}
+
+        // Opciones de partida (grabar, reproducir...); sin config, las de por defecto
+        void setRunConfig(const RunConfig* config) {run_config = config;}
+        const RunConfig& runConfig() const {return this->run_config ? *this->run_config : default_config;}
+
+        // Con un provider, un estado nuevo no se activa hasta que sus assets
+        // están listos (mientras tanto sigue el estado actual)
+        void setAssetProvider(AssetProvider* provider) {asset_provider = provider;}
+        AssetProvider* assets() {return this->asset_provider;}
+        bool has_state() const {return !this->states_machine.empty();}
     
     private:
         std::stack<std::unique_ptr<GameState>> states_machine;
         std::unique_ptr<GameState> new_state;
         bool is_running;
+        TextureCache* texture_cache = nullptr;
+        SpriteBatch* sprite_batch = nullptr;
+        InputQueue* input_queue = nullptr;
+        const RunConfig* run_config = nullptr;
+        RunConfig default_config;
+        AssetProvider* asset_provider = nullptr;
+        std::vector<const char*> pending_assets;
+        bool assets_requested = false;   // listAssets del estado nuevo ya pedido al provider
+        std::mutex pending_mutex;        // protege new_state y los flags de la petición
+
+        bool new_state_ready();
 
-        bool is_removing = false,
-             is_Adding = false,
-             is_Replacing = false,
-             is_ending = false;
+        std::atomic<bool> is_removing{false},
+                          is_Adding{false},
+                          is_ending{false};
+        bool is_Replacing = false;
 };
\ No newline at end of file
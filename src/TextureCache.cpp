@@ -0,0 +1,228 @@
+#include "TextureCache.hpp"
+#include "Profiler.hpp"
+#include <utility>
+
+// --- TextureRef
+
+TextureRef::TextureRef(TextureCache* cache, int slot) : cache_(cache), slot_(slot) {
+    cache_->addRef(slot_);
+}
+
+TextureRef::TextureRef(const TextureRef& other) : cache_(other.cache_), slot_(other.slot_) {
+    if (cache_) cache_->addRef(slot_);
+}
+
+TextureRef::TextureRef(TextureRef&& other) noexcept : cache_(other.cache_), slot_(other.slot_) {
+    other.cache_ = nullptr;
+    other.slot_ = -1;
+}
+
+TextureRef& TextureRef::operator=(const TextureRef& other) {
+    if (this != &other) {
+        TextureRef copy(other);
+        *this = std::move(copy);
+    }
+    return *this;
+}
+
+TextureRef& TextureRef::operator=(TextureRef&& other) noexcept {
+    if (this != &other) {
+        reset();
+        cache_ = other.cache_;
+        slot_ = other.slot_;
+        other.cache_ = nullptr;
+        other.slot_ = -1;
+    }
+    return *this;
+}
+
+TextureRef::~TextureRef() {
+    reset();
+}
+
+void TextureRef::reset() {
+    if (cache_) cache_->release(slot_);
+    cache_ = nullptr;
+    slot_ = -1;
+}
+
+const Sprite& TextureRef::get() const {
+    static const Sprite empty{};
+    return cache_ ? cache_->sprite(slot_) : empty;
+}
+
+const CollisionMask& TextureRef::mask() const {
+    static const CollisionMask empty{};
+    return cache_ ? cache_->mask(slot_) : empty;
+}
+
+// --- TextureCache
+
+TextureCache::~TextureCache() {
+    clear();
+}
+
+int TextureCache::find(const char* path) const {
+    for (int i = 0; i < (int)entries_.size(); i++) {
+        const Entry& e = entries_[i];
+        if ((e.sprite.valid() || e.failed) && e.path == path) return i;
+    }
+    return -1;
+}
+
+int TextureCache::freeSlot() {
+    for (int i = 0; i < (int)entries_.size(); i++) {
+        const Entry& e = entries_[i];
+        if (!e.sprite.valid() && !e.failed && e.refs == 0) return i;
+    }
+    entries_.emplace_back();
+    return (int)entries_.size() - 1;
+}
+
+TextureRef TextureCache::acquire(const char* path) {
+    int slot = find(path);
+    if (slot >= 0) return TextureRef(this, slot);
+
+    // No está residente (ni precargada): una lectura de disco y una subida a
+    // GPU; la máscara sale de la misma imagen, antes de soltarla
+    Texture2D tex{};
+    CollisionMask mask;
+    {
+        ProfileScope prof(ProfPhase::TextureLoad);
+        Image img = LoadImage(path);
+        if (img.data) {
+            mask = buildMask(img);
+            tex = LoadTextureFromImage(img);
+            UnloadImage(img);
+        }
+    }
+    diskLoads_++;
+
+    slot = freeSlot();
+    Entry& e = entries_[slot];
+    e.path = path;
+    e.sprite = wholeTexture(tex);
+    e.packed = false;
+    e.refs = 0;
+    e.idle = 0;
+    e.failed = !tex.id;   // el handle da un sprite vacío, y los siguientes también sin leer disco
+    e.mask = std::make_unique<CollisionMask>(std::move(mask));
+    return TextureRef(this, slot);
+}
+
+bool TextureCache::loadPack(const char* path) {
+    if (atlas_.id || !pack_.open(path)) return false;
+
+    // Los píxeles ya están decodificados: del mapeado a la GPU sin pasar por
+    // LoadImage ni zlib
+    {
+        ProfileScope prof(ProfPhase::TextureLoad);
+        Image img{ const_cast<uint8_t*>(pack_.pixels()), pack_.width(), pack_.height(), 1,
+                   PIXELFORMAT_UNCOMPRESSED_R8G8B8A8 };
+        atlas_ = LoadTextureFromImage(img);
+    }
+    diskLoads_++;
+    if (!atlas_.id) {
+        pack_.close();
+        return false;
+    }
+
+    stale_ = 0;
+    for (const AssetPack::Entry& p : pack_.entries()) {
+        if (find(p.path.c_str()) >= 0) continue;   // ya subida suelta: se queda esa
+        if (!AssetPack::upToDate(p)) {             // PNG editado tras empaquetar: se usa el PNG
+            stale_++;
+            continue;
+        }
+        Entry& e = entries_[freeSlot()];
+        e.path = p.path;
+        e.sprite = Sprite{ atlas_, Rectangle{(float)p.x, (float)p.y, (float)p.width, (float)p.height},
+                           p.width, p.height };
+        e.packed = true;
+        e.refs = 0;
+        e.mask.reset();
+    }
+    return true;
+}
+
+int TextureCache::packedCount() const {
+    int n = 0;
+    for (const auto& e : entries_) n += e.packed && e.sprite.valid();
+    return n;
+}
+
+CollisionMask TextureCache::buildMask(Image& img) {
+    CollisionMask mask;
+    if (!img.data) return mask;
+    ImageFormat(&img, PIXELFORMAT_UNCOMPRESSED_R8G8B8A8);
+    mask.build(static_cast<const uint8_t*>(img.data), img.width, img.height);
+    return mask;
+}
+
+const CollisionMask& TextureCache::mask(int slot) {
+    Entry& e = entries_[slot];
+    if (!e.mask) {
+        // Solo las del pack llegan sin máscara: sus píxeles están mapeados
+        e.mask = std::make_unique<CollisionMask>();
+        if (e.packed) {
+            const Rectangle& r = e.sprite.src;
+            const uint8_t* px = pack_.pixels() + ((size_t)r.y * pack_.width() + (size_t)r.x) * 4;
+            e.mask->build(px, e.sprite.width, e.sprite.height, pack_.width() * 4);
+        }
+    }
+    return *e.mask;
+}
+
+void TextureCache::adopt(const char* path, Texture2D tex, CollisionMask mask) {
+    if (!tex.id) return;
+    diskLoads_++;   // el PNG lo leyó un hilo del AssetLoader
+    int slot = find(path);
+    if (slot >= 0 && !entries_[slot].failed) {   // ya había llegado por otro camino
+        UnloadTexture(tex);
+        return;
+    }
+    if (slot < 0) slot = freeSlot();   // si falló antes, esta vez sí se leyó
+    Entry& e = entries_[slot];
+    e.path = path;
+    e.sprite = wholeTexture(tex);
+    e.packed = false;
+    e.idle = 0;
+    e.failed = false;
+    e.mask = std::make_unique<CollisionMask>(std::move(mask));
+}
+
+void TextureCache::purgeUnused(int grace) {
+    // Los del pack no liberan nada por separado: se quedan hasta clear().
+    // Las fallidas se olvidan igual, y se reintentan si se vuelven a pedir.
+    for (auto& e : entries_) {
+        if (e.refs > 0 || e.packed || (!e.sprite.valid() && !e.failed)) {
+            e.idle = 0;
+            continue;
+        }
+        if (++e.idle <= grace) continue;
+        if (e.sprite.valid()) UnloadTexture(e.sprite.tex);
+        e.sprite = Sprite{};
+        e.failed = false;
+        e.idle = 0;
+        e.mask.reset();
+    }
+}
+
+void TextureCache::clear() {
+    // Los handles que queden vivos devolverán un sprite vacío (id 0)
+    for (auto& e : entries_) {
+        if (e.sprite.valid() && !e.packed) UnloadTexture(e.sprite.tex);
+        e.sprite = Sprite{};
+        e.packed = false;
+        e.failed = false;
+    }
+    if (atlas_.id) UnloadTexture(atlas_);
+    atlas_ = Texture2D{};
+    pack_.close();
+}
+
+int TextureCache::residentCount() const {
+    int n = 0;
+    for (const auto& e : entries_) n += e.sprite.valid();
+    return n;
+}
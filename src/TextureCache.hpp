@@ -0,0 +1,122 @@
+#pragma once
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "AssetPack.hpp"
+#include "CollisionMask.hpp"
+#include "Sprite.hpp"
+
+extern "C" {
+    #include <raylib.h>
+}
+
+class TextureCache;
+
+// Handle con cuenta de referencias a una textura de la caché.
+// Copiarlo suma una referencia; destruirlo la resta. La textura nunca la
+// descarga el handle: solo la caché (purgeUnused/clear).
+class TextureRef {
+public:
+    TextureRef() = default;
+    TextureRef(const TextureRef& other);
+    TextureRef(TextureRef&& other) noexcept;
+    TextureRef& operator=(const TextureRef& other);
+    TextureRef& operator=(TextureRef&& other) noexcept;
+    ~TextureRef();
+
+    bool valid() const { return cache_ != nullptr; }
+    void reset();
+
+    // Con el pack cargado, tex es el atlas compartido: para tamaños usar
+    // los del sprite (->width), nunca los de ->tex
+    const Sprite& get() const;
+    const Sprite* operator->() const { return &get(); }
+    operator const Sprite&() const { return get(); }
+
+    // Máscara de colisión de la textura (se queda en la caché con ella). Las
+    // de PNG sueltos se hacen al decodificar, con los mismos píxeles; las del
+    // pack, la primera vez que se piden, del pack mapeado. Nunca lee disco.
+    // Vacía si no hay textura.
+    const CollisionMask& mask() const;
+
+private:
+    friend class TextureCache;
+    TextureRef(TextureCache* cache, int slot);
+
+    TextureCache* cache_{nullptr};
+    int slot_{-1};
+};
+
+// Caché de texturas por ruta. Vive junto al StateMachine (lo crea main), así
+// que sobrevive a las transiciones: reiniciar partida no vuelve a leer disco
+// ni a subir nada a la GPU. Las entradas sin referencias se quedan residentes
+// hasta que purgeUnused() (main, tras cada transición) ve que llevan más de
+// una transición sin usarse, o hasta clear().
+//
+// Con loadPack() todos los sprites del pack quedan residentes de una vez,
+// como trozos de una sola textura; lo que no esté en el pack sigue
+// viniendo de su PNG.
+class TextureCache {
+public:
+    TextureCache() = default;
+    ~TextureCache();
+
+    TextureCache(const TextureCache&) = delete;
+    TextureCache& operator=(const TextureCache&) = delete;
+
+    TextureRef acquire(const char* path);
+
+    // Mapea el pack y sube su atlas (una sola textura). false si no está o
+    // no es válido: entonces todo sale de los PNG sueltos, como siempre. Las
+    // entradas cuyo PNG cambió después de empaquetar también salen del PNG.
+    bool loadPack(const char* path);
+    int packedCount() const;
+    int stalePackCount() const { return stale_; }   // entradas del pack ignoradas por PNG más nuevo
+
+    bool resident(const char* path) const { return find(path) >= 0; }
+    // Textura ya subida y su máscara (la caché pasa a ser dueña de ambas)
+    void adopt(const char* path, Texture2D tex, CollisionMask mask);
+
+    // Máscara de una imagen recién decodificada (la deja en RGBA8). Solo CPU:
+    // la usan los hilos del AssetLoader antes de soltar los píxeles.
+    static CollisionMask buildMask(Image& img);
+
+    // Tras cada transición (main, ya con init() del estado nuevo hecho):
+    // descarga las que llevan más de `grace` transiciones seguidas sin
+    // handles vivos. Con 1, lo que va y viene entre dos estados (partida ↔
+    // game over) se queda; lo de un estado que ya no vuelve, a la segunda.
+    void purgeUnused(int grace = 1);
+    void clear();         // descarga todo (llamar antes de CloseWindow)
+
+    int residentCount() const;
+    int diskLoads() const { return diskLoads_; }   // ficheros leídos desde el inicio (PNG o pack)
+
+private:
+    friend class TextureRef;
+
+    struct Entry {
+        std::string path;
+        Sprite sprite{};
+        bool packed{false};   // trozo del atlas: no se descarga suelto
+        int refs{0};
+        int idle{0};          // transiciones seguidas sin handles (purgeUnused)
+        bool failed{false};   // no se pudo leer: no se vuelve a intentar en cada acquire
+        std::unique_ptr<CollisionMask> mask;   // en el heap: su dirección no cambia si entries_ crece
+    };
+
+    int find(const char* path) const;   // residente o fallida
+    int freeSlot();
+
+    void addRef(int slot)  { entries_[slot].refs++; }
+    void release(int slot) { entries_[slot].refs--; }
+    const Sprite& sprite(int slot) const { return entries_[slot].sprite; }
+    const CollisionMask& mask(int slot);
+
+    // Pocas decenas de entradas: búsqueda lineal, sin hash ni nodos
+    std::vector<Entry> entries_;
+    AssetPack pack_;        // sigue mapeado: de él salen las máscaras
+    Texture2D atlas_{};
+    int diskLoads_{0};
+    int stale_{0};
+};
@@ -0,0 +1,43 @@
+#pragma once
+#include <atomic>
+#include <cstdint>
+
+// Triple buffer sin locks para un productor y un consumidor. El productor
+// escribe siempre en back() y publica; el consumidor se queda con la última
+// publicación completa en front(). Ninguno espera al otro: si el productor
+// publica dos veces antes de que el consumidor mire, la primera se pierde
+// (para snapshots de render es justo lo que se quiere).
+template <typename T>
+class TripleBuffer {
+public:
+    // --- Productor
+    T& back() { return slots_[back_].value; }
+
+    void publish() {
+        // El slot escrito pasa al medio (marcado como nuevo) y nos quedamos
+        // con el que hubiera allí
+        back_ = (uint8_t)(middle_.exchange((uint8_t)(back_ | FRESH), std::memory_order_acq_rel) & INDEX);
+    }
+
+    // --- Consumidor
+    // Se queda con lo último publicado; false si no había nada nuevo
+    bool update() {
+        if (!(middle_.load(std::memory_order_relaxed) & FRESH)) return false;
+        front_ = (uint8_t)(middle_.exchange(front_, std::memory_order_acq_rel) & INDEX);
+        return true;
+    }
+
+    const T& front() const { return slots_[front_].value; }
+
+private:
+    static constexpr uint8_t INDEX = 0x3;
+    static constexpr uint8_t FRESH = 0x4;
+
+    // Cada slot en su línea de caché: productor y consumidor no se pisan
+    struct alignas(64) Slot { T value{}; };
+
+    Slot slots_[3];
+    alignas(64) std::atomic<uint8_t> middle_{1};
+    uint8_t back_{0};    // solo productor
+    uint8_t front_{2};   // solo consumidor
+};
@@ -0,0 +1,64 @@
+#include "Viewport.hpp"
+#include <cmath>
+#include <cstring>
+
+Viewport::Viewport(int width, int height, Upscale mode)
+: width_(width), height_(height), mode_(mode) {
+    target_ = LoadRenderTexture(width_, height_);
+    setMode(mode_);
+}
+
+Viewport::~Viewport() {
+    if (target_.id) UnloadRenderTexture(target_);
+}
+
+void Viewport::begin() {
+    BeginTextureMode(target_);
+}
+
+void Viewport::end() {
+    EndTextureMode();
+}
+
+void Viewport::setMode(Upscale mode) {
+    mode_ = mode;
+    SetTextureFilter(target_.texture,
+                     mode_ == Upscale::Bilinear ? TEXTURE_FILTER_BILINEAR : TEXTURE_FILTER_POINT);
+}
+
+Rectangle Viewport::dest() const {
+    const float sw = (float)GetScreenWidth();
+    const float sh = (float)GetScreenHeight();
+    float scale = std::fmin(sw / width_, sh / height_);
+
+    // Entero si cabe al menos 1:1; si la ventana es más pequeña que el
+    // frame nativo no queda otra que reducir
+    if (mode_ == Upscale::Integer && scale >= 1.0f) scale = std::floor(scale);
+
+    const float w = std::floor(width_ * scale);
+    const float h = std::floor(height_ * scale);
+    return Rectangle{ std::floor((sw - w) * 0.5f), std::floor((sh - h) * 0.5f), w, h };
+}
+
+void Viewport::present() {
+    ClearBackground(BLACK);   // bandas del letterbox
+
+    // Los RenderTexture de OpenGL están boca abajo: altura negativa en el origen
+    const Rectangle src{ 0.0f, 0.0f, (float)width_, -(float)height_ };
+    DrawTexturePro(target_.texture, src, dest(), Vector2{0.0f, 0.0f}, 0.0f, WHITE);
+}
+
+Upscale parseUpscale(const char* name) {
+    if (!std::strcmp(name, "nearest"))  return Upscale::Nearest;
+    if (!std::strcmp(name, "bilinear")) return Upscale::Bilinear;
+    return Upscale::Integer;
+}
+
+const char* upscaleName(Upscale mode) {
+    switch (mode) {
+        case Upscale::Integer:  return "integer";
+        case Upscale::Nearest:  return "nearest";
+        case Upscale::Bilinear: return "bilinear";
+        default:                return "?";
+    }
+}
@@ -0,0 +1,49 @@
+#pragma once
+
+extern "C" {
+    #include <raylib.h>
+}
+
+// Resolución lógica del juego: toda la maqueta (y la simulación) va en
+// estos píxeles, sea cual sea el tamaño de la ventana.
+constexpr int LOGICAL_W = 288;
+constexpr int LOGICAL_H = 512;
+
+// Cómo se escala el frame nativo a la ventana
+enum class Upscale : int {
+    Integer = 0,   // múltiplo entero más grande que quepa, sin filtrar (píxeles nítidos)
+    Nearest,       // ocupa todo lo que pueda, sin filtrar
+    Bilinear,      // ocupa todo lo que pueda, filtrado
+};
+
+// Frame a resolución nativa en un RenderTexture2D. Los estados dibujan entre
+// begin() y end(); present() lo lleva a la ventana con un único quad
+// escalado y bandas negras. El coste de rasterizar el juego no depende del
+// tamaño de la ventana: solo el blit final crece con ella.
+class Viewport {
+public:
+    Viewport(int width, int height, Upscale mode);
+    ~Viewport();
+
+    Viewport(const Viewport&) = delete;
+    Viewport& operator=(const Viewport&) = delete;
+
+    void begin();     // BeginTextureMode
+    void end();       // EndTextureMode
+    void present();   // dentro de BeginDrawing/EndDrawing
+
+    void setMode(Upscale mode);
+    Upscale mode() const { return mode_; }
+
+    // Rectángulo de la ventana donde cae el frame (para el último present)
+    Rectangle dest() const;
+
+private:
+    RenderTexture2D target_{};
+    int width_;
+    int height_;
+    Upscale mode_;
+};
+
+Upscale parseUpscale(const char* name);   // "integer" | "nearest" | "bilinear"
+const char* upscaleName(Upscale mode);
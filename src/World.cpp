@@ -0,0 +1,216 @@
+#include "World.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace {
+    // Por encima de esto el scroll se rebasa (float pierde precisión)
+    const float SCROLL_REBASE = 4096.0f;
+
+    // FNV-1a sobre los bytes de un valor (floats por bits: igualdad exacta)
+    template <typename T>
+    uint32_t fnv(uint32_t h, const T& v) {
+        unsigned char bytes[sizeof(T)];
+        std::memcpy(bytes, &v, sizeof(T));
+        for (unsigned char b : bytes) { h ^= b; h *= 16777619u; }
+        return h;
+    }
+}
+
+void PipeField::reset(const WorldParams& params, float gap, uint32_t seed) {
+    params_ = params;
+    gap_ = gap;
+    seed_ = seed;
+    spawned_ = 0;
+
+    // Máximo de parejas vivas a la vez: las que caben entre que nacen en el
+    // borde derecho y salen por el izquierdo, más margen.
+    const float travel  = params_.screenW + params_.pipeW;
+    const float spacing = std::max(params_.pipeSpeed * params_.spawnEvery, 1.0f);
+    int need = (int)std::ceil(travel / spacing) + 2;
+    int cap = 4;
+    while (cap < need && cap < MAX_PIPES) cap <<= 1;
+    mask_ = cap - 1;
+    head_ = 0;
+    count_ = 0;
+    scoredCount_ = 0;
+    scroll_ = 0.0f;
+
+    spawnTimer_ = 0.0f;
+    passed_ = 0;
+}
+
+void PipeField::advance(float dt, float scoreLineX) {
+    // Spawner
+    spawnTimer_ += dt;
+    if (spawnTimer_ >= params_.spawnEvery) {
+        spawnTimer_ -= params_.spawnEvery;   // conserva el resto: cadencia exacta a cualquier dt
+        spawnPipe();
+    }
+
+    // Mover tuberías: un solo offset para todas
+    scroll_ += params_.pipeSpeed * dt;
+    if (scroll_ > SCROLL_REBASE) {
+        for (int i = 0; i < count_; i++) at(i).spawnX -= scroll_;
+        scroll_ = 0.0f;
+    }
+
+    // Borrar las que salieron (siempre por la cabeza: están ordenadas por x)
+    while (count_ > 0 && x(at(0)) + params_.pipeW < 0) {
+        head_ = (head_ + 1) & mask_;
+        count_--;
+        if (scoredCount_ > 0) scoredCount_--;
+    }
+
+    // Puntuación: la línea la comparten todos los pájaros (misma x)
+    while (scoredCount_ < count_ && x(at(scoredCount_)) + params_.pipeW < scoreLineX) {
+        at(scoredCount_).scored = true;
+        scoredCount_++;
+        passed_++;
+    }
+}
+
+void PipeField::overlapping(float x0, float x1, int& first, int& last) const {
+    // Ordenadas por x (y todas igual de anchas): búsqueda binaria de la
+    // primera cuyo borde derecho pasa de x0, y de ahí hacia la derecha
+    const float w = params_.pipeW;
+    int lo = 0, hi = count_;
+    while (lo < hi) {
+        int mid = (lo + hi) >> 1;
+        if (x((*this)[mid]) + w <= x0) lo = mid + 1;
+        else hi = mid;
+    }
+    first = lo;
+    while (lo < count_ && x((*this)[lo]) < x1) lo++;
+    last = lo;
+}
+
+uint32_t PipeField::hash(uint32_t h) const {
+    h = fnv(h, scroll_);
+    h = fnv(h, spawnTimer_);
+    h = fnv(h, passed_);
+    h = fnv(h, seed_);
+    h = fnv(h, spawned_);
+    h = fnv(h, count_);
+    for (int i = 0; i < count_; i++) {
+        const PipePair& p = (*this)[i];
+        h = fnv(h, p.spawnX);
+        h = fnv(h, p.topY);
+        h = fnv(h, p.botY);
+        h = fnv(h, (uint8_t)p.red);
+    }
+    return h;
+}
+
+PipeField::PipeSpec PipeField::spec(uint32_t k) const {
+    // Centro del hueco restringido por márgenes y suelo
+    const float minCenter = params_.gapMargin + gap_ * 0.5f;
+    const float maxCenter = params_.screenH - params_.groundH - params_.gapMargin - gap_ * 0.5f;
+
+    PipeSpec s;
+    s.gapCenterY = (float)counterInt(seed_, RngStream::PipeGap, k, (int)minCenter, (int)maxCenter);
+    s.red = counterInt(seed_, RngStream::PipeColor, k, 0, 1) == 1; // usa pipe rojo o verde
+    return s;
+}
+
+void PipeField::spawnPipe() {
+    const float pipeH = params_.pipeH;
+    const PipeSpec s = spec(spawned_++);
+
+    PipePair pp;
+    pp.spawnX = params_.screenW + scroll_;   // nace en el borde derecho
+    pp.topY = s.gapCenterY - gap_ * 0.5f - pipeH;
+    pp.botY = s.gapCenterY + gap_ * 0.5f;
+    pp.red = s.red;
+
+    // Capacidad calculada en reset; si aun así se llena (parámetros por
+    // encima de MAX_PIPES) se pisa la más antigua
+    if (count_ == mask_ + 1) {
+        head_ = (head_ + 1) & mask_;
+        count_--;
+        if (scoredCount_ > 0) scoredCount_--;
+    }
+    ring_[(head_ + count_) & mask_] = pp;
+    count_++;
+}
+
+void World::reset(const WorldParams& params, uint32_t seed) {
+    params_ = params;
+
+    bird_ = Bird{};
+    bird_.width  = params_.birdW;
+    bird_.height = params_.birdH;
+    bird_.x = params_.birdStartX;
+    bird_.y = params_.screenH * params_.birdStartYFrac;
+    prevBird_ = bird_;
+
+    gap_ = gapFor(params_);
+    field_.reset(params_, gap_, seed);
+
+    score_ = 0;
+    dead_ = false;
+    birdFrame_ = 1;   // mid
+    animTimer_ = 0.0f;
+}
+
+uint32_t World::stateHash() const {
+    uint32_t h = 2166136261u;
+    h = fnv(h, bird_.y);
+    h = fnv(h, bird_.vy);
+    h = fnv(h, score_);
+    h = fnv(h, (uint8_t)dead_);
+    h = fnv(h, birdFrame_);
+    return field_.hash(h);
+}
+
+void World::step(float dt, bool flap) {
+    if (dead_ || !(dt > 0.0f)) return;
+
+    prevBird_ = bird_;
+
+    // Aleteo: el frame que se verá tras este paso es el que choca
+    animTimer_ += dt;
+    if (animTimer_ >= BIRD_FRAME_TIME) {
+        animTimer_ -= BIRD_FRAME_TIME;
+        birdFrame_ = (birdFrame_ + 1) % 3;
+    }
+
+    // Física del pájaro (según enunciado, independiente del paso)
+    bird_.vy = tickVelocity(params_, dt, flap);
+    bird_.y += bird_.vy * dt;
+
+    // Salida de pantalla → muerto
+    if (bird_.y < 0 || bird_.y + bird_.height > params_.screenH - params_.groundH) {
+        dead_ = true;
+        return;
+    }
+
+    // Tuberías: spawner, movimiento, borrado y puntuación
+    field_.advance(dt, bird_.x);
+    score_ = field_.passed();
+
+    // AABB del jugador (ahora por width/height)
+    Rectangle playerBB{ bird_.x, bird_.y, (float)bird_.width, (float)bird_.height };
+
+    // Colisiones: solo las parejas que solapan en x con el pájaro
+    int first, last;
+    field_.overlapping(playerBB.x, playerBB.x + playerBB.width, first, last);
+    for (int i = first; i < last; i++) {
+        const PipePair& p = field_[i];
+        if (overlaps(playerBB, field_.topRect(p)) || overlaps(playerBB, field_.botRect(p))) {
+            if (masks_.valid() && !pixelHit(p)) continue;
+            dead_ = true;
+            return;
+        }
+    }
+}
+
+bool World::pixelHit(const PipePair& p) const {
+    // Desplazamiento de cada tubería respecto al pájaro, en píxeles enteros
+    const CollisionMask& bird = *masks_.bird[birdFrame_];
+    const int dx   = (int)std::lround(field_.x(p) - bird_.x);
+    const int dTop = (int)std::lround(p.topY - bird_.y);
+    const int dBot = (int)std::lround(p.botY - bird_.y);
+    return masksOverlap(bird, *masks_.pipeTop[p.red], dx, dTop) ||
+           masksOverlap(bird, *masks_.pipe[p.red], dx, dBot);
+}
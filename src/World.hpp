@@ -0,0 +1,207 @@
+#pragma once
+#include <cstdint>
+#include "CounterRng.hpp"
+#include "CollisionMask.hpp"
+
+// Solo usamos los tipos de raylib (Rectangle); World no llama a ninguna
+// función de raylib, así que se puede simular sin ventana ni GPU.
+extern "C" {
+    #include <raylib.h>
+}
+
+// x,y = esquina superior-izquierda del sprite del pájaro
+struct Bird {
+    float x{120.0f};
+    float y{200.0f};
+    float vy{0.0f};
+    int   width{0};
+    int   height{0};
+};
+
+// Una pareja de tuberías. No guarda su x en pantalla: guarda dónde nació en
+// coordenadas de scroll y PipeField::x() le resta el scroll común.
+struct PipePair {
+    float spawnX{0.0f};  // x de mundo al nacer (x en pantalla = spawnX - scroll)
+    float topY{0.0f};    // y de la superior (esquina superior-izquierda)
+    float botY{0.0f};    // y de la inferior
+    bool scored{false};
+    bool red{false};     // color de esta pareja (false=green, true=red)
+};
+
+// Todo lo que el mundo necesita saber, como datos planos: dimensiones de
+// pantalla/suelo/sprites y parámetros de juego. MainGameState lo rellena a
+// partir de las texturas; un test o un bot lo pueden rellenar a mano.
+struct WorldParams {
+    // Pantalla y suelo (px lógicos)
+    float screenW{288.0f};
+    float screenH{512.0f};
+    float groundH{112.0f};
+
+    // Tamaño del pájaro y de cada tubería (los da el sprite)
+    int   birdW{34};
+    int   birdH{24};
+    float pipeW{52.0f};
+    float pipeH{320.0f};
+
+    // Posición inicial: un poco hacia la derecha y centrada vertical
+    float birdStartX{128.0f};
+    float birdStartYFrac{0.42f};
+
+    // Física básica. El modelo del enunciado se calibró a 60 FPS; physicsHz
+    // es esa frecuencia de referencia y hace que la física no dependa del
+    // paso de simulación (ver World::step).
+    float gravity{6500.0f};
+    float jump{-2600.0f};
+    float physicsHz{60.0f};
+
+    // Tuberías y spawner
+    float pipeSpeed{140.0f};  // px/s
+    float spawnEvery{1.25f};  // s (un poco más ágil)
+
+    // Hueco: max(bird.h*gapMult, gapMinPx); márgenes para que nunca salgan imposibles
+    float gapMult{4.5f};
+    float gapMinPx{96.0f};
+    float gapMargin{20.0f};
+};
+
+// Campo de tuberías compartido: spawner, scroll, borrado y paso de la línea
+// de puntuación. Lo usan World (un pájaro) y Flock (muchos).
+//
+// Las tuberías viven en un ring buffer de capacidad fija, dentro del propio
+// objeto (ni reset ni spawn tocan el heap), ordenado por x, y se mueven todas
+// a la vez con un único offset de scroll: avanzar un tick no toca ninguna
+// tubería.
+class PipeField {
+public:
+    static constexpr int MAX_PIPES = 256;   // potencia de 2; tope de parejas vivas
+
+    void reset(const WorldParams& params, float gap, uint32_t seed);
+
+    // Spawnea, mueve y borra tuberías; marca como puntuadas las que dejan
+    // atrás la línea x = scoreLineX.
+    void advance(float dt, float scoreLineX);
+
+    int passed() const { return passed_; }   // tuberías que cruzaron la línea
+
+    // Tuberías vivas, de la más antigua (izquierda) a la más nueva (derecha)
+    int count() const { return count_; }
+    const PipePair& operator[](int i) const { return ring_[(head_ + i) & mask_]; }
+
+    float x(const PipePair& p) const { return p.spawnX - scroll_; }
+    Rectangle topRect(const PipePair& p) const { return Rectangle{ x(p), p.topY, params_.pipeW, params_.pipeH }; }
+    Rectangle botRect(const PipePair& p) const { return Rectangle{ x(p), p.botY, params_.pipeW, params_.pipeH }; }
+
+    // Broad phase: índices [first, last) de las parejas que solapan en x con
+    // el intervalo abierto (x0, x1). Normalmente 0, 1 o 2 parejas.
+    void overlapping(float x0, float x1, int& first, int& last) const;
+
+    // Mezcla en h (FNV-1a) todo lo que determina el futuro del campo
+    uint32_t hash(uint32_t h) const;
+
+    // Tubería k-ésima desde reset (la 0 es la primera que nace): función
+    // pura de (semilla, k), así que se puede mirar cualquiera sin generar
+    // las anteriores (precalcular las que vienen, saltar en repeticiones...)
+    struct PipeSpec {
+        float gapCenterY;
+        bool  red;
+    };
+    PipeSpec spec(uint32_t k) const;
+    uint32_t spawned() const { return spawned_; }   // cuántas han nacido
+
+private:
+    void spawnPipe();                 // la siguiente según spec(spawned_)
+    PipePair& at(int i) { return ring_[(head_ + i) & mask_]; }
+
+    WorldParams params_{};
+    float gap_{0.0f};
+    float spawnTimer_{0.0f};
+    int   passed_{0};
+
+    // Ring buffer; en uso solo las primeras mask_+1 (potencia de 2)
+    PipePair ring_[MAX_PIPES];
+    int head_{0};
+    int count_{0};
+    int mask_{0};
+    int scoredCount_{0};   // las primeras scoredCount_ vivas ya están puntuadas
+
+    float scroll_{0.0f};   // distancia recorrida; se rebasa para no perder precisión
+
+    uint32_t seed_{0};     // semilla del mundo (ver CounterRng.hpp)
+    uint32_t spawned_{0};  // índice de la próxima tubería
+};
+
+// Igual que CheckCollisionRecs de raylib, sin depender de la librería
+inline bool overlaps(const Rectangle& a, const Rectangle& b) {
+    return a.x < b.x + b.width && a.x + a.width > b.x &&
+           a.y < b.y + b.height && a.y + a.height > b.y;
+}
+
+// Simulación pura del juego: pájaro, tuberías, spawner y puntuación.
+// Se avanza con step(dt, flap), donde flap es el bit de entrada del tick.
+// Un paso con dt <= 0 (o NaN) no hace nada.
+class World {
+public:
+    static constexpr float BIRD_FRAME_TIME = 0.15f;   // s por frame de aleteo
+
+    World() = default;
+
+    void reset(const WorldParams& params, uint32_t seed);
+    void step(float dt, bool flap);
+
+    // Con máscaras válidas, un solape de AABB solo mata si se tocan píxeles
+    // opacos (la del pájaro según su frame de aleteo). Sin ellas (por
+    // defecto, p. ej. en herramientas sin texturas) basta el AABB.
+    void setMasks(const CollisionMasks& masks) { masks_ = masks; }
+    bool pixelCollision() const { return masks_.valid(); }
+
+    bool dead() const { return dead_; }
+    int  score() const { return score_; }
+    float gap() const { return gap_; }
+
+    const Bird& bird() const { return bird_; }
+    const Bird& prevBird() const { return prevBird_; }   // estado antes del último step (interpolación)
+    int birdFrame() const { return birdFrame_; }          // 0 down, 1 mid, 2 up
+    const PipeField& pipes() const { return field_; }
+    const WorldParams& params() const { return params_; }
+
+    // Huella del estado tras el último step (pájaro, campo, puntuación):
+    // dos mundos con la misma semilla y la misma entrada dan la misma.
+    // La usan las repeticiones para detectar desincronizaciones.
+    uint32_t stateHash() const;
+
+private:
+    WorldParams params_{};
+    Bird bird_{};
+    Bird prevBird_{};
+    PipeField field_;
+
+    float gap_{0.0f};
+    int   score_{0};
+    bool  dead_{false};
+
+    // Aleteo: forma parte de la simulación porque cambia la máscara del pájaro
+    int   birdFrame_{1};
+    float animTimer_{0.0f};
+    CollisionMasks masks_{};
+
+    bool pixelHit(const PipePair& p) const;
+};
+
+// Velocidad vertical de un tick según el modelo del enunciado (vy se
+// recalcula desde cero en cada tick). Expresada respecto a physicsHz:
+// caída constante de gravity/physicsHz px/s y un salto que desplaza
+// jump/physicsHz px, así a 60 Hz da lo mismo que el original
+// (vy = jump + gravity*dt) y a 240 Hz el juego se siente igual. Sin dt > 0
+// no hay salto (dividiría por cero); los step() ya no llegan aquí con él.
+inline float tickVelocity(const WorldParams& params, float dt, bool flap) {
+    const float refDt = 1.0f / params.physicsHz;
+    float vy = params.gravity * refDt;
+    if (flap && dt > 0.0f) vy += params.jump * refDt / dt;
+    return vy;
+}
+
+// Hueco entre tuberías para unos parámetros: max(bird.h*gapMult, gapMinPx)
+inline float gapFor(const WorldParams& params) {
+    float g = params.birdH * params.gapMult;
+    return g > params.gapMinPx ? g : params.gapMinPx;
+}
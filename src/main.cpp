@@ -4,32 +4,315 @@ extern "C" {
 
 #include "StateMachine.hpp"
 #include "MainGameState.hpp"
+#include "TextureCache.hpp"
+#include "SpriteBatch.hpp"
+#include "AssetLoader.hpp"
+#include "FixedStep.hpp"
+#include "SimThread.hpp"
+#include "Options.hpp"
+#include "Profiler.hpp"
+#include "DebugOverlay.hpp"
+#include "Viewport.hpp"
+#include "AllocTracker.hpp"
+#include "InputQueue.hpp"
+#include "Replay.hpp"
+#include "Autopilot.hpp"
+#include <algorithm>
 #include <memory>
 
-int main() {
-    const int W = 288;
-    const int H = 512;
+int main(int argc, char** argv) {
+    const double startTime = inputNow();   // para medir el tiempo hasta el primer frame
+    const Options opts = parseOptions(argc, argv);
+    int exitCode = 0;
 
-    InitWindow(W, H, "Flappy Bird DCA");
-    SetTargetFPS(60);
+    // Ventana redimensionable: el juego se dibuja siempre a LOGICAL_W x LOGICAL_H
+    // y Viewport lo escala a lo que mida la ventana
+    SetConfigFlags(FLAG_WINDOW_RESIZABLE);
+    InitWindow(LOGICAL_W * opts.windowScale, LOGICAL_H * opts.windowScale, "Flappy Bird DCA");
+    SetWindowMinSize(LOGICAL_W / 2, LOGICAL_H / 2);
 
-    StateMachine sm;
-    sm.add_state(std::make_unique<MainGameState>(&sm), false);
+    // 60 FPS como antes, pero sin SetTargetFPS: la espera hasta el siguiente
+    // frame la hace InputQueue::waitUntil sondeando teclado cada ~1 ms
+    const double FRAME_TIME = 1.0 / 60.0;
 
-    while (!sm.is_game_ending() && !WindowShouldClose()) {
-        float dt = GetFrameTime();
+    {
+        // La caché se declara antes que sm: los estados sueltan sus handles
+        // primero y las texturas se descargan antes de CloseWindow.
+        TextureCache textures;
+        AssetLoader loader(textures, opts.loaderThreads);
+        if (opts.packPath && textures.loadPack(opts.packPath)) {
+            TraceLog(LOG_INFO, "PACK: %d sprites de %s en una textura", textures.packedCount(), opts.packPath);
+            if (textures.stalePackCount() > 0) {
+                TraceLog(LOG_WARNING, "PACK: %d PNG cambiaron después de empaquetar; salen del PNG (tools/packer)",
+                         textures.stalePackCount());
+            }
+        } else if (opts.packPath) {
+            TraceLog(LOG_INFO, "PACK: sin %s (tools/packer); texturas desde los PNG", opts.packPath);
+        }
+        static SpriteBatch sprites;   // ~50 KB de quads: fuera de la pila
+        Viewport viewport(LOGICAL_W, LOGICAL_H, opts.upscale);
+        InputQueue input;
+
+        // Una repetición se reproduce a la frecuencia con que se grabó
+        RunConfig runConfig;
+        runConfig.simHz       = opts.simHz;
+        runConfig.recordPath  = opts.recordPath;
+        runConfig.replayPath  = opts.replayPath;
+        runConfig.publishPath = opts.publishPath;
+        runConfig.ghostPaths  = opts.ghostPaths;
+        if (opts.replayPath) {
+            ReplayReader peek;
+            if (peek.open(opts.replayPath)) runConfig.simHz = peek.header().simHz;
+        }
+
+        // Piloto automático: los pesos se leen una vez; cada partida los usa
+        Autopilot autopilot;
+        if (opts.autopilotPath) {
+            if (autopilot.load(opts.autopilotPath)) {
+                runConfig.autopilot = &autopilot;
+                TraceLog(LOG_INFO, "AUTOPILOT: pesos de %s", opts.autopilotPath);
+            } else {
+                TraceLog(LOG_WARNING, "AUTOPILOT: no se pudieron leer los pesos de %s (tools/train)", opts.autopilotPath);
+            }
+        }
+
+        StateMachine sm;
+        sm.setTextureCache(&textures);
+        sm.setSpriteBatch(&sprites);
+        sm.setInput(&input);
+        sm.setRunConfig(&runConfig);
+        sm.setAssetProvider(&loader);
+        sm.add_state(std::make_unique<MainGameState>(&sm), false);
+
+        // Simulación a paso fijo (opts.simHz), independiente del framerate;
+        // el render interpola entre los dos últimos pasos. Con --sim-thread
+        // los pasos los da SimThread en su hilo y aquí solo se dibuja.
+        FixedStep clock(runConfig.simHz, opts.maxCatchUpSteps);
+        SimThread simThread(sm, runConfig.simHz, opts.maxCatchUpSteps);
+        double simSeconds = 0.0;
+        bool showProfiler = false;
+
+        // Reservas por frame/estado (contadores reales solo en Debug)
+        FrameAllocAudit allocAudit(opts.allocWarmupFrames);
+        long long frames = 0;
+
+        // Latencia tecla → frame presentado (--input-latency)
+        LatencyLog latency;
+        double lastPresentedInput = 0.0;
+
+        double frameStart = inputNow();
+        double deadline = frameStart + FRAME_TIME;
+        bool firstFrameShown = false;
+        bool wasFocused = true;
+        bool wasMinimized = false;
+        float alpha = 0.0f;   // se conserva mientras la simulación está en pausa
+
+        while (!sm.is_game_ending() && !WindowShouldClose()) {
+            allocAudit.beginFrame();
+            const double now = inputNow();
+            float dt = (float)(now - frameStart);
+            frameStart = now;
+
+            // Subidas a GPU de lo que los hilos ya decodificaron, con tope por frame
+            loader.pumpUploads(opts.uploadBudgetMs);
+
+            bool changed = false;
+            {
+                ProfileScope prof(ProfPhase::StateChanges);
+                // Ningún estado se toca desde el hilo de simulación mientras
+                // se aplica un cambio: primero se para y luego se aplica. Si
+                // lo pide justo después de mirar (p. ej. al morir), se queda
+                // para el frame siguiente, que también lo parará antes
+                if (sm.has_pending_changes()) {
+                    simThread.stop();
+                    changed = sm.handle_state_changes(dt);
+                }
+                if (changed) {
+                    clock.reset();
+                    alpha = 0.0f;
+                    textures.purgeUnused();   // el estado nuevo ya tiene sus handles (init)
+                }
+            }
+
+            GameState* st = sm.has_state() ? sm.getCurrentState().get() : nullptr;
+            if (st) {
+                // Sin foco o minimizada: en pausa y pocos frames; minimizada, ni se dibuja.
+                // Al cambiar el foco, el tamaño o el estado, se vuelve a presentar.
+                const bool focused = IsWindowFocused();
+                const bool minimized = IsWindowMinimized();
+                const bool background = !focused || minimized;
+                if (changed || IsWindowResized() || focused != wasFocused || minimized != wasMinimized) {
+                    st->markDirty();
+                }
+                // En segundo plano la simulación se pausa (a 1/--background-fps
+                // con el tope de pasos iría a cámara lenta): se para el hilo y,
+                // al volver, el tiempo que pasó fuera no se recupera
+                if (background && simThread.running()) simThread.stop();
+                if (!background && (!wasFocused || wasMinimized)) {
+                    clock.reset();
+                    dt = 0.0f;
+                }
+                wasFocused = focused;
+                wasMinimized = minimized;
+
+                {
+                    ProfileScope prof(ProfPhase::Input);
+                    if (input.pressed(KEY_F3)) {
+                        showProfiler = !showProfiler;
+                        st->markDirty();
+                    }
+                    if (input.pressed(KEY_F2)) {
+                        viewport.setMode((Upscale)(((int)viewport.mode() + 1) % 3));
+                        TraceLog(LOG_INFO, "VIEWPORT: escalado %s", upscaleName(viewport.mode()));
+                        st->markDirty();
+                    }
+                    st->handleInput();
+                    input.clear();
+                }
+
+                // Un estado estático no avanza con el tiempo: sin pasos
+                const bool stepping = st->animating() && !background;
+                if (stepping && opts.simThread) {
+                    if (!simThread.running() && !sm.has_pending_changes()) simThread.start(st);
+                    alpha = simThread.alpha();
+                } else if (stepping) {
+                    const int steps = clock.advance(dt);
+                    {
+                        ProfileScope prof(ProfPhase::Update);
+                        const double t0 = GetTime();
+                        // Los pasos de este frame cubren steps*dt segundos que
+                        // acaban lag() antes de ahora (el resto del acumulador,
+                        // que aún no se ha simulado): cada evento cae en el suyo
+                        double stepStart = now - clock.lag() - steps * (double)clock.dt();
+                        for (int i = 0; i < steps && !sm.has_pending_changes(); i++) {
+                            st->setStepStart(stepStart);
+                            st->update(clock.dt());
+                            stepStart += clock.dt();
+                        }
+                        simSeconds += GetTime() - t0;
+                    }
+                    alpha = clock.alpha();
+                }
 
-        sm.handle_state_changes(dt);
+                // Solo se dibuja y presenta si el frame puede ser distinto
+                // del último; si no, la ventana conserva el que ya tiene
+                const bool dirty = st->takeDirty();
+                const bool redraw = !minimized && (dirty || stepping || showProfiler);
+                if (redraw) {
+                    {
+                        ProfileScope prof(ProfPhase::Render);
+                        viewport.begin();
+                        st->render(alpha);
+                        viewport.end();
+
+                        // Un solo blit escalado; el overlay va encima a resolución de ventana
+                        BeginDrawing();
+                        viewport.present();
+                        if (showProfiler) drawProfilerOverlay(profiler());
+                    }
+                    {
+                        ProfileScope prof(ProfPhase::Present);
+                        EndDrawing();
+                    }
+                    input.collect();
+
+                    // Swap hecho: la entrada que refleja este frame ya es visible
+                    const double shown = st->presentedInputTime();
+                    if (opts.inputLatency && shown > lastPresentedInput) {
+                        latency.add(inputNow() - shown);
+                        lastPresentedInput = shown;
+                    }
+
+                    if (!firstFrameShown) {
+                        TraceLog(LOG_INFO, "STARTUP: primer frame a %.1f ms, %d lecturas de textura",
+                                 (inputNow() - startTime) * 1e3, textures.diskLoads());
+                        firstFrameShown = true;
+                    }
+                }
+
+                // Espera hasta el siguiente frame. Con un estado estático y
+                // nada pendiente no hay frame siguiente hasta que llegue un
+                // evento: se bloquea ahí (salvo con --frames, que tiene que
+                // acabar solo). Sin foco, con la simulación en pausa, suele ser
+                // el caso; si aún queda trabajo (cargas, --frames) el frame
+                // dura 1/--background-fps y se duerme de una vez, sin sondear.
+                const bool idle = !redraw && !stepping && !sm.has_pending_changes() &&
+                                  loader.pending() == 0 && opts.maxFrames == 0;
+                if (background) deadline = std::max(deadline, now + 1.0 / opts.backgroundFps);
+                {
+                    ProfileScope prof(ProfPhase::Wait);
+                    if (idle) {
+                        input.waitForEvents();
+                        deadline = inputNow();
+                    } else if (background) {
+                        input.sleepUntil(deadline);
+                    } else {
+                        input.waitUntil(deadline);
+                    }
+                }
+            } else {
+                // Arranque: el primer estado aún espera a sus texturas
+                BeginDrawing();
+                ClearBackground(RAYWHITE);
+                EndDrawing();
+                input.clear();
+                ProfileScope prof(ProfPhase::Wait);
+                input.waitUntil(deadline);
+            }
+
+            // Si vamos tarde no se acumula deuda: el siguiente frame sale ya
+            deadline += FRAME_TIME;
+            if (deadline < inputNow()) deadline = inputNow();
+
+            profiler().endFrame();
+
+            if (allocAudit.endFrame(st ? st->name() : "loading", changed) && opts.allocCheck) {
+                TraceLog(LOG_ERROR, "ALLOC: el frame %lld (%s) reservó %llu veces en régimen estable",
+                         frames, st ? st->name() : "loading",
+                         (unsigned long long)allocAudit.lastFrameAllocs());
+                exitCode = 1;
+                break;
+            }
+            if (opts.maxFrames > 0 && ++frames >= opts.maxFrames) break;
+        }
+
+        simThread.stop();
+        if (opts.inputLatency) {
+            const LatencyLog::Stats l = latency.stats();
+            TraceLog(LOG_INFO, "LATENCY: %d saltos, tecla -> frame presentado p50 %.2f ms, p99 %.2f ms, max %.2f ms",
+                     latency.count(), l.p50, l.p99, l.max);
+        }
+        if (simThread.totalSteps() > 0) {
+            TraceLog(LOG_INFO, "SIM: %lld pasos a %.0f Hz en su hilo, %.2f us/paso, %.3f s descartados por tope",
+                     simThread.totalSteps(), runConfig.simHz,
+                     simThread.simSeconds() * 1e6 / (double)simThread.totalSteps(), simThread.droppedTime());
+        }
+        if (clock.totalSteps() > 0) {
+            TraceLog(LOG_INFO, "SIM: %lld pasos a %.0f Hz, %.2f us/paso, %.3f s descartados por tope",
+                     clock.totalSteps(), runConfig.simHz,
+                     simSeconds * 1e6 / (double)clock.totalSteps(), clock.droppedTime());
+        }
+
+        if (allocTrackingEnabled()) {
+            for (int i = 0; i < allocAudit.stateCount(); i++) {
+                const FrameAllocAudit::StateAllocs& a = allocAudit.state(i);
+                TraceLog(LOG_INFO, "ALLOC: %-14s %lld frames, %llu reservas, %lld frames estables con reservas",
+                         a.name, a.frames, (unsigned long long)a.allocs, a.allocatingSteadyFrames);
+            }
+        } else if (opts.allocCheck) {
+            TraceLog(LOG_WARNING, "ALLOC: --alloc-check sin FLAPPY_ALLOC_TRACKING (compila en Debug)");
+        }
+    }
 
-        auto* st = sm.getCurrentState().get();
-        if (st) {
-            st->handleInput();
-            st->update(dt);
-            st->render();
+    if (opts.profileCsv) {
+        if (profiler().writeCsv(opts.profileCsv)) {
+            TraceLog(LOG_INFO, "PROFILER: %lld frames volcados en %s", profiler().frameCount(), opts.profileCsv);
+        } else {
+            TraceLog(LOG_WARNING, "PROFILER: no se pudo escribir %s", opts.profileCsv);
         }
     }
 
     CloseWindow();
-    return 0;
+    return exitCode;
 }
 
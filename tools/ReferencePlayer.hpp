@@ -0,0 +1,85 @@
+#pragma once
+#include "CounterRng.hpp"
+#include "Flock.hpp"
+
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+// Lo común de las herramientas que simulan partidas (sweep, ghosts, train,
+// bench): el aleatorio de los jugadores y el jugador de referencia. Un
+// solo sitio para que todas jueguen igual.
+
+// Secuencia con estado sobre counterRng (el mismo generador que World,
+// en su propio flujo): el valor k de la secuencia de `seed` es el k-ésimo
+// que se pide
+struct ToolRng {
+    uint32_t seed;
+    uint32_t k{0};
+
+    uint32_t next() { return (uint32_t)(counterRng(seed, RngStream::Tools, k++) >> 32); }
+    float uniform() { return ((float)(next() >> 8) + 0.5f) * (1.0f / 16777216.0f); }   // (0,1)
+    float normal() {   // Box-Muller: igual en cualquier biblioteca estándar
+        return std::sqrt(-2.0f * std::log(uniform())) * std::cos(6.2831853f * uniform());
+    }
+};
+
+// Centro del hueco de la primera pareja que el pájaro aún no ha pasado (sin
+// ninguna, un poco por encima del centro de la pantalla)
+inline float nextGapCenter(const WorldParams& p, const PipeField& f, float birdX) {
+    const float gap = gapFor(p);
+    for (int i = 0; i < f.count(); i++) {
+        if (f.x(f[i]) + p.pipeW >= birdX) return f[i].botY - gap * 0.5f;
+    }
+    return p.screenH * 0.42f;
+}
+
+// --- Jugador de referencia: salta cuando el pájaro baja a menos de
+// REFERENCE_MARGIN_PX del borde inferior del hueco de la siguiente tubería
+constexpr float REFERENCE_MARGIN_PX = 20.0f;
+
+// Sin ruido, para un World (bench)
+inline bool referenceFlap(const World& w) {
+    const Bird& b = w.bird();
+    const float bottom = nextGapCenter(w.params(), w.pipes(), b.x) + gapFor(w.params()) * 0.5f;
+    return b.y + b.height > bottom - REFERENCE_MARGIN_PX;
+}
+
+// Con ruido, para todos los pájaros de un Flock: cada uno apunta al borde
+// desplazado aimOffset (fijo por pájaro) y, cuando toca saltar, lo hace con
+// un retraso aleatorio de hasta maxDelayTicks ticks
+struct PlayerConfig {
+    float aimNoisePx{12.0f};
+    int   maxDelayTicks{14};
+};
+
+class ReferencePlayer {
+public:
+    ReferencePlayer(int birds, uint32_t seed, const PlayerConfig& pc)
+    : rng_{ seed }, pc_(pc), aim_(birds), delay_(birds, -1) {
+        for (float& a : aim_) a = (rng_.uniform() * 2.0f - 1.0f) * pc_.aimNoisePx;
+    }
+
+    // flaps[i] = 1 si el pájaro i salta este tick (antes de flock.step)
+    void decide(const Flock& flock, uint8_t* flaps) {
+        const WorldParams& p = flock.params();
+        const float bottom = nextGapCenter(p, flock.field(), flock.birdX()) + gapFor(p) * 0.5f;
+        const float h = (float)p.birdH;
+        const float* y = flock.y();
+        for (int i = 0; i < (int)aim_.size(); i++) {
+            flaps[i] = 0;
+            if (!flock.alive(i)) continue;
+            if (delay_[i] < 0 && y[i] + h > bottom - REFERENCE_MARGIN_PX + aim_[i]) {
+                delay_[i] = (int16_t)(pc_.maxDelayTicks > 0 ? rng_.next() % (uint32_t)(pc_.maxDelayTicks + 1) : 0);
+            }
+            if (delay_[i] == 0) flaps[i] = 1;
+            if (delay_[i] >= 0) delay_[i]--;
+        }
+    }
+
+private:
+    ToolRng rng_;
+    PlayerConfig pc_;
+    std::vector<float> aim_;
+    std::vector<int16_t> delay_;   // -1: sin salto pendiente
+};
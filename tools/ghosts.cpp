@@ -0,0 +1,166 @@
+// Loopback de los flujos de fantasmas (GhostStream) sin ventana ni sockets:
+// N partidas simuladas (un Flock con el jugador de referencia con ruido) se
+// codifican cada una en su flujo, que se decodifica en vivo como lo haría el
+// juego: a 60 FPS, pasándole solo los bytes que ya existen.
+//
+//   ghosts [--birds N] [--seconds S] [--seed S] [--aim-noise PX] [--out DIR]
+//
+// Informa de bytes por segundo y pájaro, coste de decodificación por
+// fantasma y frame, y error de la y reconstruida frente a la real: en vivo
+// (extrapolando tras la última muestra) y con un periodo de retraso
+// (interpolando; salvo cuantización, exacta si hubo un salto o ninguno). Con
+// --out deja cada flujo en DIR/ghost-I.fbg para verlos en el juego con
+// --ghost. Sale con 1 si alguna muestra no se reconstruye exacta.
+
+#include "Flock.hpp"
+#include "GhostStream.hpp"
+#include "ReferencePlayer.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace {
+
+float percentile(std::vector<float>& v, float p) {
+    if (v.empty()) return 0.0f;
+    std::sort(v.begin(), v.end());
+    return v[std::min(v.size() - 1, (size_t)(p * (float)v.size()))];
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    int birds = 200;
+    double seconds = 60.0;
+    uint32_t seed = 12345;
+    float aimNoise = 12.0f;
+    const char* outDir = nullptr;
+    for (int i = 1; i < argc; i++) {
+        const char* a = argv[i];
+        const bool hasValue = i + 1 < argc;
+        if (!std::strcmp(a, "--birds") && hasValue)          birds = std::max(1, std::atoi(argv[++i]));
+        else if (!std::strcmp(a, "--seconds") && hasValue)   seconds = std::atof(argv[++i]);
+        else if (!std::strcmp(a, "--seed") && hasValue)      seed = (uint32_t)std::strtoul(argv[++i], nullptr, 10);
+        else if (!std::strcmp(a, "--aim-noise") && hasValue) aimNoise = (float)std::atof(argv[++i]);
+        else if (!std::strcmp(a, "--out") && hasValue)       outDir = argv[++i];
+        else {
+            std::fprintf(stderr, "uso: ghosts [--birds N] [--seconds S] [--seed S] [--aim-noise PX] [--out DIR]\n");
+            return 2;
+        }
+    }
+
+    GhostHeader header;
+    header.seed = seed;
+    const WorldParams params;
+    const float dt = (float)(1.0 / header.simHz);
+    const int ticksPerFrame = (int)std::lround(header.simHz / 60.0);
+    const int maxTicks = (int)(seconds * header.simHz);
+
+    Flock flock;
+    flock.reset(params, seed, birds);
+
+    std::vector<GhostEncoder> encoders(birds, GhostEncoder(header));
+    std::vector<GhostDecoder> decoders(birds);
+    std::vector<std::vector<uint8_t>> streams(outDir ? birds : 0);
+    std::vector<size_t> bytes(birds, 0);
+    std::vector<int> deathTick(birds, -1);
+
+    PlayerConfig pc;   // el de sweep, con el ruido de --aim-noise
+    pc.aimNoisePx = aimNoise;
+    ReferencePlayer player(birds, seed ^ 0x6057u, pc);
+    std::vector<uint8_t> flaps(birds, 0);
+
+    // Error en vivo (extrapolando tras la última muestra) y con un periodo
+    // de muestreo de retraso (siempre interpolando); para lo segundo hace
+    // falta la y real de hace sampleEvery ticks
+    std::vector<float> errors, delayedErrors;
+    errors.reserve((size_t)birds * (maxTicks / ticksPerFrame + 1));
+    delayedErrors.reserve(errors.capacity());
+    const int HISTORY = 64;
+    std::vector<float> truth((size_t)birds * HISTORY, 0.0f);
+    double decodeSeconds = 0.0;
+    long long decodes = 0;
+    int badSamples = 0;
+
+    using Clock = std::chrono::steady_clock;
+    int tick = 0;
+    for (; tick < maxTicks && flock.aliveCount() > 0; tick++) {
+        player.decide(flock, flaps.data());
+        flock.step(dt, flaps.data());
+        for (int i = 0; i < birds; i++) truth[(size_t)i * HISTORY + tick % HISTORY] = flock.y()[i];
+
+        // Publicar: cada pájaro a su flujo
+        for (int i = 0; i < birds; i++) {
+            if (deathTick[i] >= 0) continue;
+            const bool dead = !flock.alive(i);
+            if (dead) deathTick[i] = tick;
+            encoders[i].step((uint32_t)tick, flock.y()[i], flock.vy()[i], flock.score()[i],
+                             flock.field().spawned(), dead, flaps[i] != 0);
+            const std::vector<uint8_t>& out = encoders[i].buffer();
+            if (out.empty()) continue;
+            bytes[i] += out.size();
+            decoders[i].feed(out.data(), out.size());
+            if (outDir) streams[i].insert(streams[i].end(), out.begin(), out.end());
+            encoders[i].consumed();
+        }
+
+        // Ver: cada frame, todos los fantasmas vivos en este tick
+        if (tick % ticksPerFrame != 0) continue;
+        const auto t0 = Clock::now();
+        for (int i = 0; i < birds; i++) {
+            decoders[i].advanceTo((uint32_t)tick);
+            if (deathTick[i] >= 0) continue;
+            float y;
+            if (decoders[i].positionAt((uint32_t)tick, 0.0f, y)) {
+                errors.push_back(std::fabs(y - flock.y()[i]));
+                if (tick % header.sampleEvery == 0 && errors.back() > 0.5f / GhostEncoder::QUANT + 1e-3f) badSamples++;
+            }
+            const int back = tick - header.sampleEvery;
+            if (back >= 0 && decoders[i].positionAt((uint32_t)back, 0.0f, y)) {
+                delayedErrors.push_back(std::fabs(y - truth[(size_t)i * HISTORY + back % HISTORY]));
+            }
+        }
+        decodeSeconds += std::chrono::duration<double>(Clock::now() - t0).count();
+        decodes += birds;
+    }
+
+    const double simSeconds = tick / header.simHz;
+    double bytesPerSecond = 0.0;
+    for (int i = 0; i < birds; i++) {
+        const int alive = deathTick[i] < 0 ? tick : deathTick[i] + 1;
+        bytesPerSecond += (double)bytes[i] / std::max(1.0, alive / header.simHz);
+    }
+    bytesPerSecond /= birds;
+
+    std::printf("fantasmas %d, %.1f s simulados, %d siguen vivos\n", birds, simSeconds, flock.aliveCount());
+    std::printf("ancho de banda: %.1f B/s por pájaro (de media mientras vive)\n", bytesPerSecond);
+    std::printf("decodificación: %.1f ns por fantasma y frame\n", decodes ? decodeSeconds * 1e9 / (double)decodes : 0.0);
+    const float p50 = percentile(errors, 0.5f), p99 = percentile(errors, 0.99f), max = percentile(errors, 1.0f);
+    std::printf("error de y en vivo: p50 %.2f px, p99 %.2f px, max %.2f px; muestras inexactas: %d\n",
+                p50, p99, max, badSamples);
+    const float d50 = percentile(delayedErrors, 0.5f), d99 = percentile(delayedErrors, 0.99f),
+                dmax = percentile(delayedErrors, 1.0f);
+    std::printf("error de y con %d ticks de retraso: p50 %.2f px, p99 %.2f px, max %.2f px\n",
+                header.sampleEvery, d50, d99, dmax);
+
+    if (outDir) {
+        for (int i = 0; i < birds; i++) {
+            const std::string path = std::string(outDir) + "/ghost-" + std::to_string(i) + ".fbg";
+            FILE* f = std::fopen(path.c_str(), "wb");
+            if (!f) {
+                std::fprintf(stderr, "%s: no se pudo escribir\n", path.c_str());
+                return 2;
+            }
+            std::fwrite(streams[i].data(), 1, streams[i].size(), f);
+            std::fclose(f);
+        }
+        std::printf("%d flujos en %s/ghost-*.fbg\n", birds, outDir);
+    }
+    return badSamples ? 1 : 0;
+}
@@ -0,0 +1,109 @@
+// Empaqueta los PNG de una carpeta en un solo pack (.fbpak, ver AssetPack)
+// para que el juego arranque sin abrir ni descomprimir uno por uno.
+//
+//   packer [CARPETA] [SALIDA]      (por defecto: assets assets/pack.fbpak)
+//
+// Las rutas del índice son CARPETA/nombre.png, las mismas que pide el juego
+// a TextureCache::acquire: ejecutar desde la raíz del repo. El atlas se
+// llena por estantes (de más alto a más bajo) con 1 píxel transparente
+// entre sprites. Guarda el mtime y el tamaño de cada PNG: si luego cambia,
+// el juego usa el PNG en vez del trozo viejo hasta volver a empaquetar.
+// Sale con 1 si algún PNG no se puede leer o no cabe.
+
+#include "AssetPack.hpp"
+
+extern "C" {
+    #include <raylib.h>
+}
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace {
+    const int MAX_WIDTH = 1024;   // ancho de estante (o el del sprite más ancho)
+    const int PADDING   = 1;
+
+    struct Input {
+        std::string path;
+        Image image;
+    };
+}
+
+int main(int argc, char** argv) {
+    const char* dir = argc > 1 ? argv[1] : "assets";
+    const char* out = argc > 2 ? argv[2] : "assets/pack.fbpak";
+    SetTraceLogLevel(LOG_WARNING);
+
+    // Orden por nombre: el mismo pack sale igual byte a byte
+    FilePathList files = LoadDirectoryFilesEx(dir, ".png", false);
+    std::vector<Input> inputs;
+    for (unsigned i = 0; i < files.count; i++) {
+        Input in{ std::string(dir) + "/" + GetFileName(files.paths[i]), LoadImage(files.paths[i]) };
+        if (!in.image.data) {
+            std::fprintf(stderr, "%s: no se pudo leer\n", files.paths[i]);
+            UnloadDirectoryFiles(files);
+            return 1;
+        }
+        ImageFormat(&in.image, PIXELFORMAT_UNCOMPRESSED_R8G8B8A8);
+        inputs.push_back(in);
+    }
+    UnloadDirectoryFiles(files);
+    if (inputs.empty()) {
+        std::fprintf(stderr, "%s: no hay PNG\n", dir);
+        return 1;
+    }
+    std::sort(inputs.begin(), inputs.end(),
+              [](const Input& a, const Input& b) { return a.path < b.path; });
+
+    // Estantes: colocar de más alto a más bajo desperdicia poco con sprites
+    // de alturas tan distintas (fondos de 512, dígitos de 36)
+    std::vector<int> order(inputs.size());
+    for (size_t i = 0; i < order.size(); i++) order[i] = (int)i;
+    std::stable_sort(order.begin(), order.end(),
+                     [&](int a, int b) { return inputs[a].image.height > inputs[b].image.height; });
+
+    int width = MAX_WIDTH;
+    for (const Input& in : inputs) width = std::max(width, in.image.width);
+
+    std::vector<AssetPack::Entry> entries(inputs.size());
+    int x = 0, y = 0, shelfH = 0, usedW = 0;
+    for (int i : order) {
+        const Image& img = inputs[i].image;
+        if (x + img.width > width) {
+            x = 0;
+            y += shelfH + PADDING;
+            shelfH = 0;
+        }
+        entries[i] = AssetPack::Entry{ inputs[i].path, x, y, img.width, img.height };
+        AssetPack::sourceStamp(inputs[i].path.c_str(), entries[i].sourceMtimeNs, entries[i].sourceSize);
+        x += img.width + PADDING;
+        shelfH = std::max(shelfH, img.height);
+        usedW = std::max(usedW, x - PADDING);
+    }
+    width = usedW;
+    const int height = y + shelfH;
+
+    std::vector<uint8_t> atlas((size_t)width * height * 4, 0);
+    for (size_t i = 0; i < inputs.size(); i++) {
+        const Image& img = inputs[i].image;
+        const AssetPack::Entry& e = entries[i];
+        for (int row = 0; row < img.height; row++) {
+            std::memcpy(&atlas[((size_t)(e.y + row) * width + e.x) * 4],
+                        static_cast<const uint8_t*>(img.data) + (size_t)row * img.width * 4,
+                        (size_t)img.width * 4);
+        }
+        UnloadImage(img);
+    }
+
+    if (!writeAssetPack(out, width, height, atlas.data(), entries)) {
+        std::fprintf(stderr, "%s: no se pudo escribir (¿ruta de más de %d bytes o atlas de más de 65535?)\n",
+                     out, AssetPack::PATH_BYTES - 1);
+        return 1;
+    }
+    std::printf("%s: %zu sprites en un atlas de %dx%d (%.1f MB)\n",
+                out, entries.size(), width, height, (double)atlas.size() / (1024.0 * 1024.0));
+    return 0;
+}
@@ -0,0 +1,296 @@
+// Barrido de dificultad: para cada punto de una rejilla de parámetros
+// (spawnEvery, pipeSpeed, gapMult, gapMinPx, gapMargin) juega muchas
+// partidas simuladas con un jugador de referencia con ruido y saca la
+// distribución de supervivencia y puntuación. CSV por stdout (o --out).
+//
+//   sweep [--spawn L] [--speed L] [--gap-mult L] [--gap-min L] [--margin L]
+//         [--games N] [--batch B] [--threads T] [--max-seconds S]
+//         [--sim-hz H] [--aim-noise PX] [--reaction-ms MS] [--seed S]
+//         [--out FICHERO]
+//
+// L es un valor, una lista "a,b,c" o un rango "desde:hasta:paso".
+//
+// Cada tarea es un Flock de B pájaros sobre un mismo campo de tuberías
+// (una semilla); cada pájaro es una partida con su propio ruido. Las tareas
+// se reparten entre todos los núcleos con robo de trabajo: cada hilo vacía
+// su cola por el final y, cuando se queda sin nada, roba por el principio
+// de la de otro.
+
+#include "Flock.hpp"
+#include "ReferencePlayer.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace {
+
+// --- Rejilla
+
+bool parseList(const char* s, std::vector<float>& out) {
+    out.clear();
+    float a, b, step;
+    if (std::sscanf(s, "%f:%f:%f", &a, &b, &step) == 3) {
+        if (step <= 0.0f || b < a) return false;
+        const int n = (int)std::floor((b - a) / step + 1e-4f) + 1;
+        for (int i = 0; i < n; i++) out.push_back(a + step * (float)i);
+        return true;
+    }
+    for (const char* p = s; *p; ) {
+        char* end;
+        const float v = std::strtof(p, &end);
+        if (end == p) return false;
+        out.push_back(v);
+        p = (*end == ',') ? end + 1 : end;
+    }
+    return !out.empty();
+}
+
+struct Point {
+    WorldParams params;
+};
+
+// --- Una tarea: B partidas en un punto con una semilla
+struct Task {
+    int point;
+    int batch;   // índice del lote dentro del punto
+};
+
+struct Samples {
+    std::vector<float>   survival;   // segundos
+    std::vector<int32_t> score;
+    std::vector<uint8_t> capped;     // llegó al tope sin morir
+};
+
+void runTask(const Point& pt, const Task& task, int birds, uint32_t seed,
+             float dt, int maxTicks, const PlayerConfig& pc, Samples& out, int offset) {
+    Flock flock;
+    flock.reset(pt.params, seed, birds);
+
+    // Cada partida con su propio ruido (tools/ReferencePlayer.hpp)
+    ReferencePlayer player(birds, seed ^ ((uint32_t)(task.point * 7919 + task.batch) * 0x9E3779B1u), pc);
+    std::vector<uint8_t> flaps(birds, 0);
+    std::vector<int>     deathTick(birds, -1);
+
+    int tick = 0;
+    int alive = flock.aliveCount();
+    for (; tick < maxTicks && alive > 0; tick++) {
+        player.decide(flock, flaps.data());
+        flock.step(dt, flaps.data());
+
+        if (flock.aliveCount() != alive) {
+            for (int i = 0; i < birds; i++) {
+                if (deathTick[i] < 0 && !flock.alive(i)) deathTick[i] = tick + 1;
+            }
+            alive = flock.aliveCount();
+        }
+    }
+
+    const int32_t* score = flock.score();
+    for (int i = 0; i < birds; i++) {
+        const bool cap = deathTick[i] < 0;
+        out.survival[offset + i] = (float)(cap ? tick : deathTick[i]) * dt;
+        out.score[offset + i]    = score[i];
+        out.capped[offset + i]   = cap ? 1 : 0;
+    }
+}
+
+// --- Pool con robo de trabajo. Las tareas se conocen de antemano: se
+// reparten en bloques contiguos por hilo y no se crean más, así que cuando
+// todas las colas están vacías se ha terminado.
+class WorkStealingPool {
+public:
+    explicit WorkStealingPool(int threads) : queues_(threads) {}
+
+    template <typename F>
+    void run(int taskCount, F&& fn) {
+        const int n = (int)queues_.size();
+        for (int t = 0; t < taskCount; t++) queues_[(size_t)((long long)t * n / taskCount)].tasks.push_back(t);
+
+        std::vector<std::thread> threads;
+        for (int w = 0; w < n; w++) {
+            threads.emplace_back([this, w, n, &fn] {
+                int task;
+                while (popOwn(w, task) || steal(w, n, task)) fn(task);
+            });
+        }
+        for (auto& t : threads) t.join();
+    }
+
+    long long steals() const { return steals_.load(); }
+
+private:
+    struct Queue {
+        std::mutex m;
+        std::deque<int> tasks;
+    };
+
+    bool popOwn(int w, int& task) {
+        Queue& q = queues_[w];
+        std::lock_guard<std::mutex> lock(q.m);
+        if (q.tasks.empty()) return false;
+        task = q.tasks.back();
+        q.tasks.pop_back();
+        return true;
+    }
+
+    bool steal(int w, int n, int& task) {
+        for (int k = 1; k < n; k++) {
+            Queue& q = queues_[(w + k) % n];
+            std::lock_guard<std::mutex> lock(q.m);
+            if (q.tasks.empty()) continue;
+            task = q.tasks.front();
+            q.tasks.pop_front();
+            steals_++;
+            return true;
+        }
+        return false;
+    }
+
+    std::vector<Queue> queues_;
+    std::atomic<long long> steals_{0};
+};
+
+// --- Estadísticas
+
+template <typename T>
+float percentile(std::vector<T>& v, float p) {
+    if (v.empty()) return 0.0f;
+    const size_t k = std::min(v.size() - 1, (size_t)(p * (float)(v.size() - 1) + 0.5f));
+    std::nth_element(v.begin(), v.begin() + (long)k, v.end());
+    return (float)v[k];
+}
+
+template <typename T>
+double mean(const std::vector<T>& v) {
+    double s = 0.0;
+    for (T x : v) s += (double)x;
+    return v.empty() ? 0.0 : s / (double)v.size();
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    std::vector<float> spawn{WorldParams{}.spawnEvery}, speed{WorldParams{}.pipeSpeed},
+                       gapMult{WorldParams{}.gapMult}, gapMin{WorldParams{}.gapMinPx},
+                       margin{WorldParams{}.gapMargin};
+    int games = 4096;
+    int birds = 256;
+    int threads = (int)std::max(1u, std::thread::hardware_concurrency());
+    float maxSeconds = 120.0f;
+    float simHz = 240.0f;
+    uint32_t baseSeed = 1;
+    PlayerConfig pc;
+    float reactionMs = 60.0f;
+    const char* outPath = nullptr;
+
+    for (int i = 1; i < argc; i++) {
+        const char* a = argv[i];
+        const bool hasValue = i + 1 < argc;
+        bool ok = true;
+        if      (!std::strcmp(a, "--spawn") && hasValue)       ok = parseList(argv[++i], spawn);
+        else if (!std::strcmp(a, "--speed") && hasValue)       ok = parseList(argv[++i], speed);
+        else if (!std::strcmp(a, "--gap-mult") && hasValue)    ok = parseList(argv[++i], gapMult);
+        else if (!std::strcmp(a, "--gap-min") && hasValue)     ok = parseList(argv[++i], gapMin);
+        else if (!std::strcmp(a, "--margin") && hasValue)      ok = parseList(argv[++i], margin);
+        else if (!std::strcmp(a, "--games") && hasValue)       games = std::max(1, std::atoi(argv[++i]));
+        else if (!std::strcmp(a, "--batch") && hasValue)       birds = std::max(1, std::atoi(argv[++i]));
+        else if (!std::strcmp(a, "--threads") && hasValue)     threads = std::max(1, std::atoi(argv[++i]));
+        else if (!std::strcmp(a, "--max-seconds") && hasValue) maxSeconds = (float)std::atof(argv[++i]);
+        else if (!std::strcmp(a, "--sim-hz") && hasValue)      simHz = (float)std::atof(argv[++i]);
+        else if (!std::strcmp(a, "--aim-noise") && hasValue)   pc.aimNoisePx = (float)std::atof(argv[++i]);
+        else if (!std::strcmp(a, "--reaction-ms") && hasValue) reactionMs = (float)std::atof(argv[++i]);
+        else if (!std::strcmp(a, "--seed") && hasValue)        baseSeed = (uint32_t)std::strtoul(argv[++i], nullptr, 10);
+        else if (!std::strcmp(a, "--out") && hasValue)         outPath = argv[++i];
+        else {
+            std::fprintf(stderr, "Opción desconocida: %s\n", a);
+            return 2;
+        }
+        if (!ok) {
+            std::fprintf(stderr, "Lista no válida para %s\n", a);
+            return 2;
+        }
+    }
+    if (simHz <= 0.0f) simHz = 240.0f;
+    const float dt = 1.0f / simHz;
+    const int maxTicks = (int)(maxSeconds * simHz);
+    pc.maxDelayTicks = (int)(reactionMs * 1e-3f * simHz);
+
+    // Puntos de la rejilla
+    std::vector<Point> points;
+    for (float s : spawn) for (float v : speed) for (float gm : gapMult) for (float gn : gapMin) for (float m : margin) {
+        Point p;
+        p.params.spawnEvery = s;
+        p.params.pipeSpeed  = v;
+        p.params.gapMult    = gm;
+        p.params.gapMinPx   = gn;
+        p.params.gapMargin  = m;
+        points.push_back(p);
+    }
+
+    // Tareas: lotes de `birds` partidas por punto
+    const int batchesPerPoint = (games + birds - 1) / birds;
+    const int gamesPerPoint = batchesPerPoint * birds;
+    std::vector<Task> tasks;
+    for (int p = 0; p < (int)points.size(); p++) {
+        for (int b = 0; b < batchesPerPoint; b++) tasks.push_back(Task{p, b});
+    }
+
+    // Cada tarea escribe en su tramo: sin locks al recoger resultados
+    std::vector<Samples> samples(points.size());
+    for (auto& s : samples) {
+        s.survival.resize((size_t)gamesPerPoint);
+        s.score.resize((size_t)gamesPerPoint);
+        s.capped.resize((size_t)gamesPerPoint);
+    }
+
+    std::fprintf(stderr, "sweep: %zu puntos × %d partidas, %zu tareas en %d hilos\n",
+                 points.size(), gamesPerPoint, tasks.size(), threads);
+
+    const auto t0 = std::chrono::steady_clock::now();
+    WorkStealingPool pool(threads);
+    pool.run((int)tasks.size(), [&](int t) {
+        const Task& task = tasks[(size_t)t];
+        // Misma semilla para el lote b en todos los puntos: los puntos se
+        // comparan sobre las mismas secuencias de huecos
+        const uint32_t seed = baseSeed * 2654435761u + (uint32_t)task.batch * 40503u + 1u;
+        runTask(points[(size_t)task.point], task, birds, seed, dt, maxTicks, pc,
+                samples[(size_t)task.point], task.batch * birds);
+    });
+    const double secs = std::chrono::duration<double>(std::chrono::steady_clock::now() - t0).count();
+
+    FILE* out = outPath ? std::fopen(outPath, "w") : stdout;
+    if (!out) {
+        std::fprintf(stderr, "no se pudo abrir %s\n", outPath);
+        return 1;
+    }
+    std::fprintf(out, "spawn_every,pipe_speed,gap_mult,gap_min_px,gap_margin,gap_px,games,"
+                      "survival_mean_s,survival_p10_s,survival_p50_s,survival_p90_s,"
+                      "score_mean,score_p10,score_p50,score_p90,score_max,capped_pct\n");
+    for (size_t p = 0; p < points.size(); p++) {
+        const WorldParams& w = points[p].params;
+        Samples& s = samples[p];
+        const double capped = 100.0 * mean(s.capped);
+        std::fprintf(out, "%.3f,%.1f,%.2f,%.1f,%.1f,%.1f,%d,%.2f,%.2f,%.2f,%.2f,%.2f,%.0f,%.0f,%.0f,%d,%.1f\n",
+                     w.spawnEvery, w.pipeSpeed, w.gapMult, w.gapMinPx, w.gapMargin, gapFor(w), gamesPerPoint,
+                     mean(s.survival), percentile(s.survival, 0.10f), percentile(s.survival, 0.50f),
+                     percentile(s.survival, 0.90f),
+                     mean(s.score), percentile(s.score, 0.10f), percentile(s.score, 0.50f),
+                     percentile(s.score, 0.90f), *std::max_element(s.score.begin(), s.score.end()),
+                     capped);
+    }
+    if (out != stdout) std::fclose(out);
+
+    const double totalGames = (double)gamesPerPoint * (double)points.size();
+    std::fprintf(stderr, "sweep: %.0f partidas en %.2f s (%.0f partidas/s), %lld robos\n",
+                 totalGames, secs, totalGames / secs, pool.steals());
+    return 0;
+}
@@ -0,0 +1,257 @@
+// Entrena los pesos del piloto automático (Autopilot) por entropía cruzada:
+// cada generación prueba P políticas, cada una con un Flock de B pájaros
+// que deciden por lotes, y la siguiente se muestrea alrededor de las mejores.
+// Escribe el fichero que carga el juego con --autopilot.
+//
+//   train [--generations G] [--population P] [--birds B] [--seeds K]
+//         [--seconds S] [--reaction-ticks R] [--threads T] [--seed S]
+//         [--out FICHERO]
+//
+// Por defecto escribe assets/autopilot.txt. Cada pájaro ejecuta los saltos
+// con un retraso aleatorio de hasta R ticks (así no juegan todos igual y la
+// política aprende con margen). La aptitud es la puntuación media en K
+// campos de tuberías; todas las políticas de una generación juegan las
+// mismas K semillas (con una sola se aprende ese campo). Al final se
+// valida con semillas nuevas frente a la política inicial (el jugador de
+// referencia escrito como red) y se guarda la mejor.
+
+#include "Autopilot.hpp"
+#include "Flock.hpp"
+#include "ReferencePlayer.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+namespace {
+
+const int PARAMS = Autopilot::HIDDEN * (Autopilot::INPUTS + 2) + 1;
+const int VALIDATION_SEEDS = 16;
+
+// Weights ↔ vector plano (el orden del fichero)
+void unpack(const float* v, Autopilot::Weights& w) {
+    int k = 0;
+    for (int j = 0; j < Autopilot::HIDDEN; j++) {
+        for (int i = 0; i < Autopilot::INPUTS; i++) w.w1[j][i] = v[k++];
+        w.b1[j] = v[k++];
+        w.w2[j] = v[k++];
+    }
+    w.b2 = v[k];
+}
+
+void pack(const Autopilot::Weights& w, float* v) {
+    int k = 0;
+    for (int j = 0; j < Autopilot::HIDDEN; j++) {
+        for (int i = 0; i < Autopilot::INPUTS; i++) v[k++] = w.w1[j][i];
+        v[k++] = w.b1[j];
+        v[k++] = w.w2[j];
+    }
+    v[k] = w.b2;
+}
+
+// El jugador de referencia (tools/ReferencePlayer.hpp) como red: una
+// neurona que se enciende cuando el pájaro baja a menos de
+// REFERENCE_MARGIN_PX del borde inferior
+Autopilot::Weights referenceWeights(const WorldParams& params) {
+    Autopilot::Weights w;
+    w.w1[0][2] = -1.0f;
+    w.b1[0] = REFERENCE_MARGIN_PX / gapFor(params);
+    w.w2[0] = 1.0f;
+    w.b2 = -0.01f;
+    return w;
+}
+
+struct Score {
+    double fitness{0.0};     // puntuación media
+    double seconds{0.0};     // supervivencia media
+    double decideNs{0.0};    // inferencia por pájaro y tick
+};
+
+Score evaluate(const Autopilot& pilot, const WorldParams& params, uint32_t seed,
+               int birds, int maxTicks, float dt, int reaction) {
+    Flock flock;
+    flock.reset(params, seed, birds);
+    std::vector<uint8_t> decisions(birds), flaps(birds);
+    std::vector<int16_t> delay(birds, -1);   // -1: sin salto pendiente
+    std::vector<int> deathTick(birds, maxTicks);
+    ToolRng rng{ seed ^ 0xA070u };
+
+    using Clock = std::chrono::steady_clock;
+    double decideSeconds = 0.0;
+    long long decided = 0;
+    int alive = flock.aliveCount();
+    for (int tick = 0; tick < maxTicks && alive > 0; tick++) {
+        const auto t0 = Clock::now();
+        const Autopilot::Gap gap = Autopilot::nearestGap(params, flock.field(), flock.birdX());
+        pilot.decide(params, gap, flock.y(), flock.vy(), birds, decisions.data());
+        decideSeconds += std::chrono::duration<double>(Clock::now() - t0).count();
+        decided += birds;
+
+        for (int i = 0; i < birds; i++) {
+            flaps[i] = 0;
+            if (!flock.alive(i)) continue;
+            if (delay[i] < 0 && decisions[i]) delay[i] = (int16_t)(rng.next() % (uint32_t)(reaction + 1));
+            if (delay[i] == 0) flaps[i] = 1;
+            if (delay[i] >= 0) delay[i]--;
+        }
+        flock.step(dt, flaps.data());
+
+        if (flock.aliveCount() != alive) {
+            for (int i = 0; i < birds; i++) {
+                if (!flock.alive(i) && deathTick[i] == maxTicks) deathTick[i] = tick;
+            }
+            alive = flock.aliveCount();
+        }
+    }
+
+    Score s;
+    for (int i = 0; i < birds; i++) {
+        s.fitness += flock.score()[i];
+        s.seconds += deathTick[i] * dt;
+    }
+    s.fitness /= birds;
+    s.seconds /= birds;
+    s.decideNs = decided ? decideSeconds * 1e9 / (double)decided : 0.0;
+    return s;
+}
+
+// Media de K campos de tuberías (semillas seed + i·0x9E37)
+Score evaluateSeeds(const Autopilot& pilot, const WorldParams& params, uint32_t seed, int seeds,
+                    int birds, int maxTicks, float dt, int reaction) {
+    Score total;
+    for (int k = 0; k < seeds; k++) {
+        const Score s = evaluate(pilot, params, seed + 0x9E37u * (uint32_t)(k + 1), birds, maxTicks, dt, reaction);
+        total.fitness += s.fitness / seeds;
+        total.seconds += s.seconds / seeds;
+        total.decideNs += s.decideNs / seeds;
+    }
+    return total;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    int generations = 30;
+    int population = 48;
+    int birds = 64;
+    int seeds = 4;
+    double seconds = 60.0;
+    int reaction = 3;
+    int threads = (int)std::max(1u, std::thread::hardware_concurrency());
+    uint32_t seed = 2024;
+    const char* out = "assets/autopilot.txt";
+    for (int i = 1; i < argc; i++) {
+        const char* a = argv[i];
+        const bool hasValue = i + 1 < argc;
+        if (!std::strcmp(a, "--generations") && hasValue)         generations = std::max(1, std::atoi(argv[++i]));
+        else if (!std::strcmp(a, "--population") && hasValue)     population = std::max(4, std::atoi(argv[++i]));
+        else if (!std::strcmp(a, "--birds") && hasValue)          birds = std::max(1, std::atoi(argv[++i]));
+        else if (!std::strcmp(a, "--seeds") && hasValue)          seeds = std::max(1, std::atoi(argv[++i]));
+        else if (!std::strcmp(a, "--seconds") && hasValue)        seconds = std::atof(argv[++i]);
+        else if (!std::strcmp(a, "--reaction-ticks") && hasValue) reaction = std::max(0, std::atoi(argv[++i]));
+        else if (!std::strcmp(a, "--threads") && hasValue)        threads = std::max(1, std::atoi(argv[++i]));
+        else if (!std::strcmp(a, "--seed") && hasValue)           seed = (uint32_t)std::strtoul(argv[++i], nullptr, 10);
+        else if (!std::strcmp(a, "--out") && hasValue)            out = argv[++i];
+        else {
+            std::fprintf(stderr, "uso: train [--generations G] [--population P] [--birds B] [--seeds K]\n"
+                                 "             [--seconds S] [--reaction-ticks R] [--threads T] [--seed S]\n"
+                                 "             [--out FICHERO]\n");
+            return 2;
+        }
+    }
+
+    const WorldParams params;
+    const float dt = 1.0f / 240.0f;
+    const int maxTicks = (int)(seconds * 240.0);
+    const int elite = std::max(2, population / 6);
+
+    // Media y desviación de la distribución de pesos; se empieza en el
+    // jugador de referencia
+    float mean[PARAMS], sigma[PARAMS];
+    pack(referenceWeights(params), mean);
+    std::fill(sigma, sigma + PARAMS, 0.5f);
+
+    ToolRng rng{ seed * 0x2545F491u };
+    std::vector<float> candidates((size_t)population * PARAMS);
+    std::vector<Score> scores(population);
+    std::vector<int> order(population);
+
+    std::printf("generación  mejor  media-élite  (puntuación media, %d semillas × %d pájaros, %.0f s)\n",
+                seeds, birds, seconds);
+    for (int g = 0; g < generations; g++) {
+        for (int c = 0; c < population; c++) {
+            float* v = &candidates[(size_t)c * PARAMS];
+            for (int k = 0; k < PARAMS; k++) v[k] = c == 0 ? mean[k] : mean[k] + sigma[k] * rng.normal();
+        }
+
+        // Candidatas en paralelo, todas con las semillas de la generación
+        const uint32_t genSeed = seed + (uint32_t)g * 7919u;
+        std::atomic<int> nextCandidate{0};
+        std::vector<std::thread> pool;
+        for (int t = 0; t < threads; t++) {
+            pool.emplace_back([&] {
+                for (int c; (c = nextCandidate++) < population; ) {
+                    Autopilot::Weights w;
+                    unpack(&candidates[(size_t)c * PARAMS], w);
+                    Autopilot pilot;
+                    pilot.setWeights(w);
+                    scores[c] = evaluateSeeds(pilot, params, genSeed, seeds, birds, maxTicks, dt, reaction);
+                }
+            });
+        }
+        for (std::thread& t : pool) t.join();
+
+        for (int c = 0; c < population; c++) order[c] = c;
+        std::sort(order.begin(), order.end(), [&](int a, int b) {
+            if (scores[a].fitness != scores[b].fitness) return scores[a].fitness > scores[b].fitness;
+            return scores[a].seconds > scores[b].seconds;
+        });
+
+        // Nueva media y desviación con las élites; un mínimo que decae para
+        // no cerrarse antes de tiempo
+        const float floor = 0.05f * (1.0f - (float)g / (float)generations);
+        double eliteMean = 0.0;
+        for (int k = 0; k < PARAMS; k++) {
+            float m = 0.0f;
+            for (int e = 0; e < elite; e++) m += candidates[(size_t)order[e] * PARAMS + k];
+            m /= (float)elite;
+            float var = 0.0f;
+            for (int e = 0; e < elite; e++) {
+                const float d = candidates[(size_t)order[e] * PARAMS + k] - m;
+                var += d * d;
+            }
+            mean[k] = m;
+            sigma[k] = std::sqrt(var / (float)elite) + floor;
+        }
+        for (int e = 0; e < elite; e++) eliteMean += scores[order[e]].fitness / elite;
+        std::printf("%10d  %5.1f  %11.1f\n", g, scores[order[0]].fitness, eliteMean);
+        std::fflush(stdout);
+    }
+
+    // Validación con semillas que no se han visto
+    Autopilot reference, trained;
+    reference.setWeights(referenceWeights(params));
+    Autopilot::Weights w;
+    unpack(mean, w);
+    trained.setWeights(w);
+    const uint32_t valSeed = seed ^ 0x5EEDu;
+    const Score ref = evaluateSeeds(reference, params, valSeed, VALIDATION_SEEDS, birds, maxTicks, dt, reaction);
+    const Score res = evaluateSeeds(trained, params, valSeed, VALIDATION_SEEDS, birds, maxTicks, dt, reaction);
+    std::printf("validación (%d semillas): referencia %.1f puntos / %.1f s, entrenada %.1f puntos / %.1f s\n",
+                VALIDATION_SEEDS, ref.fitness, ref.seconds, res.fitness, res.seconds);
+    std::printf("inferencia: %.2f ns por pájaro y tick (lotes de %d)\n", res.decideNs, birds);
+
+    const Autopilot& best = res.fitness >= ref.fitness ? trained : reference;
+    if (!best.save(out)) {
+        std::fprintf(stderr, "%s: no se pudo escribir\n", out);
+        return 1;
+    }
+    std::printf("%s: pesos de la %s\n", out, &best == &trained ? "entrenada" : "referencia (no mejoró)");
+    return 0;
+}